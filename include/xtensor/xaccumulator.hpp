@@ -10,36 +10,486 @@
 #define XTENSOR_ACCUMULATOR_HPP
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
 #include <type_traits>
-#include <cstddef>
+#include <vector>
+
+#include "xtl/xsequence.hpp"
 
-#include "xtensor_forward.hpp"
-#include "xstrides.hpp"
 #include "xexpression.hpp"
-#include <iostream>
+#include "xiterable.hpp"
+#include "xparallel.hpp"
+#include "xstrides.hpp"
+#include "xtensor_forward.hpp"
+#include "xtensor_simd.hpp"
 
 namespace xt
 {
 
 #define DEFAULT_STRATEGY_ACCUMULATORS evaluation_strategy::immediate
 
+    /**
+     * Traits class telling whether an accumulating functor is associative.
+     * The parallel evaluation strategy splits a single accumulation into
+     * chunks only for associative functors; specialize it for your own
+     * functors to enable it.
+     */
+    template <class F>
+    struct is_associative : std::false_type
+    {
+    };
+
+    template <class T>
+    struct is_associative<std::plus<T>> : std::true_type
+    {
+    };
+
+    template <class T>
+    struct is_associative<std::multiplies<T>> : std::true_type
+    {
+    };
+
+    /****************
+     * scan kernels *
+     ****************/
+
+    namespace detail
+    {
+        /**
+         * Simd counterpart of an accumulating functor.
+         */
+        template <class F>
+        struct simd_scan_op
+        {
+            static constexpr bool value = false;
+        };
+
+        template <class T>
+        struct simd_scan_op<std::plus<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const std::plus<T>&, const B& lhs, const B& rhs)
+            {
+                return lhs + rhs;
+            }
+        };
+
+        template <class T>
+        struct simd_scan_op<std::multiplies<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const std::multiplies<T>&, const B& lhs, const B& rhs)
+            {
+                return lhs * rhs;
+            }
+        };
+
+        template <class F, class T>
+        struct use_simd_scan
+            : std::integral_constant<bool, simd_scan_op<F>::value && std::is_arithmetic<T>::value &&
+                                           !std::is_same<T, bool>::value && (xsimd::simd_traits<T>::size > 1)>
+        {
+        };
+
+        /**
+         * Assigns f(prev[i], cur[i]) to cur[i] for the n contiguous
+         * elements of prev and cur.
+         */
+        template <class F, class T>
+        inline void scan_slab(const F& f, const T* prev, T* cur, std::size_t n, std::true_type)
+        {
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            using op = simd_scan_op<F>;
+
+            std::size_t i = 0;
+            for (; i + simd_size <= n; i += simd_size)
+            {
+                simd_type res = op::apply(f, xsimd::load_simd<T>(prev + i, xsimd::unaligned_mode()),
+                                          xsimd::load_simd<T>(cur + i, xsimd::unaligned_mode()));
+                xsimd::store_simd<T>(cur + i, res, xsimd::unaligned_mode());
+            }
+            for (; i < n; ++i)
+            {
+                cur[i] = f(prev[i], cur[i]);
+            }
+        }
+
+        template <class F, class T>
+        inline void scan_slab(const F& f, const T* prev, T* cur, std::size_t n, std::false_type)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                cur[i] = f(prev[i], cur[i]);
+            }
+        }
+
+        /**
+         * Assigns f(carry, first[i]) to first[i] for the n contiguous
+         * elements starting at first.
+         */
+        template <class F, class T>
+        inline void apply_carry(const F& f, const T& carry, T* first, std::size_t n, std::true_type)
+        {
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            using op = simd_scan_op<F>;
+
+            simd_type c = xsimd::set_simd(carry);
+            std::size_t i = 0;
+            for (; i + simd_size <= n; i += simd_size)
+            {
+                simd_type res = op::apply(f, c, xsimd::load_simd<T>(first + i, xsimd::unaligned_mode()));
+                xsimd::store_simd<T>(first + i, res, xsimd::unaligned_mode());
+            }
+            for (; i < n; ++i)
+            {
+                first[i] = f(carry, first[i]);
+            }
+        }
+
+        template <class F, class T>
+        inline void apply_carry(const F& f, const T& carry, T* first, std::size_t n, std::false_type)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                first[i] = f(carry, first[i]);
+            }
+        }
+
+        /**
+         * Accumulates in place the n contiguous elements starting at first.
+         */
+        template <class F, class T>
+        inline void scan_contiguous(const F& f, T* first, std::size_t n, std::false_type)
+        {
+            T acc = first[0];
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                acc = f(acc, first[i]);
+                first[i] = acc;
+            }
+        }
+
+        /**
+         * Blocked parallel scan: the chunks are accumulated independently,
+         * the total of the preceding chunks is computed serially for each
+         * chunk, and is finally combined with the elements of the chunk.
+         */
+        template <class F, class T>
+        inline void scan_contiguous(const F& f, T* first, std::size_t n, std::true_type)
+        {
+            xchunks chunks = split_chunks(n);
+            if (chunks.count < 2)
+            {
+                scan_contiguous(f, first, n, std::false_type());
+                return;
+            }
+            std::size_t n_chunks = chunks.count;
+            std::size_t chunk_size = chunks.length;
+
+            parallel_for_chunks(chunks, [&f, first](std::size_t, std::size_t begin, std::size_t end) {
+                scan_contiguous(f, first + begin, end - begin, std::false_type());
+            });
+
+            std::vector<T> carries(n_chunks);
+            carries[1] = first[chunk_size - 1];
+            for (std::size_t c = 2; c < n_chunks; ++c)
+            {
+                carries[c] = f(carries[c - 1], first[c * chunk_size - 1]);
+            }
+
+            using simd = use_simd_scan<F, T>;
+            parallel_for(chunk_size, n, XTENSOR_PARALLEL_GRAIN_SIZE, [&f, &carries, first, chunk_size](std::size_t begin, std::size_t end) {
+                while (begin != end)
+                {
+                    std::size_t c = begin / chunk_size;
+                    std::size_t last = std::min(end, (c + 1) * chunk_size);
+                    apply_carry(f, carries[c], first + begin, last - begin, simd());
+                    begin = last;
+                }
+            });
+        }
+
+        template <class F>
+        inline void scan_for(std::size_t size, std::size_t grain_size, F&& f, std::true_type)
+        {
+            parallel_for(0, size, grain_size, std::forward<F>(f));
+        }
+
+        template <class F>
+        inline void scan_for(std::size_t size, std::size_t, F&& f, std::false_type)
+        {
+            f(std::size_t(0), size);
+        }
+
+        /**
+         * Accumulates in place the data of a contiguous container made of
+         * outer blocks of n slabs of s elements, along the slabs. Slabs
+         * are accumulated with simd instructions when s > 1; a single
+         * long accumulation (s == 1) is split between threads when P is
+         * std::true_type and the functor is associative.
+         */
+        template <class F, class T, class P>
+        inline void scan_data(const F& f, T* data, std::size_t outer, std::size_t n, std::size_t s, P)
+        {
+            std::size_t grain_size = std::max(std::size_t(1), XTENSOR_PARALLEL_GRAIN_SIZE / n);
+            if (s == 1)
+            {
+                using split = std::integral_constant<bool, P::value && is_associative<F>::value>;
+                if (split::value && outer < get_num_threads())
+                {
+                    for (std::size_t o = 0; o < outer; ++o)
+                    {
+                        scan_contiguous(f, data + o * n, n, split());
+                    }
+                }
+                else
+                {
+                    scan_for(outer, grain_size, [&f, data, n](std::size_t begin, std::size_t end) {
+                        for (std::size_t o = begin; o != end; ++o)
+                        {
+                            scan_contiguous(f, data + o * n, n, std::false_type());
+                        }
+                    }, P());
+                }
+            }
+            else
+            {
+                using simd = use_simd_scan<F, T>;
+                // Each lane is one of the s columns of an outer block
+                scan_for(outer * s, grain_size, [&f, data, n, s](std::size_t begin, std::size_t end) {
+                    while (begin != end)
+                    {
+                        std::size_t o = begin / s;
+                        std::size_t j = begin % s;
+                        std::size_t m = std::min(end - begin, s - j);
+                        T* block = data + o * n * s + j;
+                        for (std::size_t k = 1; k < n; ++k)
+                        {
+                            scan_slab(f, block + (k - 1) * s, block + k * s, m, simd());
+                        }
+                        begin += m;
+                    }
+                }, P());
+            }
+        }
+    }
+
+    /****************
+     * xaccumulator *
+     ****************/
+
+    template <class F, class CT>
+    class xaccumulator;
+
+    template <class F, class CT>
+    class xaccumulator_stepper;
+
+    template <class F, class CT>
+    struct xiterable_inner_types<xaccumulator<F, CT>>
+    {
+        using xexpression_type = std::decay_t<CT>;
+        using inner_shape_type = typename xexpression_type::shape_type;
+        using const_stepper = xaccumulator_stepper<F, CT>;
+        using stepper = const_stepper;
+    };
+
+    /**
+     * @class xaccumulator
+     * @brief Lazy accumulation of an expression along an axis.
+     *
+     * The xaccumulator class implements an \ref xexpression whose elements
+     * are the accumulation of the elements of an \ref xexpression along
+     * an axis, up to the same position. It does not hold any data.
+     *
+     * Accessing an element with operator() accumulates all the preceding
+     * elements along the axis. Its steppers keep the running accumulation
+     * of the slab they last went through, so that traversing the whole
+     * expression in the default layout, for instance when assigning it,
+     * reads each element of the accumulated expression once.
+     *
+     * @tparam F the accumulating functor
+     * @tparam CT the closure type of the \ref xexpression to accumulate
+     *
+     * @sa accumulate
+     */
+    template <class F, class CT>
+    class xaccumulator : public xexpression<xaccumulator<F, CT>>,
+                         public xconst_iterable<xaccumulator<F, CT>>
+    {
+    public:
+
+        using self_type = xaccumulator<F, CT>;
+        using functor_type = std::decay_t<F>;
+        using xexpression_type = std::decay_t<CT>;
+
+        using value_type = typename functor_type::result_type;
+        using reference = value_type;
+        using const_reference = value_type;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using size_type = typename xexpression_type::size_type;
+        using difference_type = typename xexpression_type::difference_type;
+
+        using iterable_base = xconst_iterable<self_type>;
+        using inner_shape_type = typename iterable_base::inner_shape_type;
+        using shape_type = inner_shape_type;
+
+        using stepper = typename iterable_base::stepper;
+        using const_stepper = typename iterable_base::const_stepper;
+
+        static constexpr layout_type static_layout = xexpression_type::static_layout;
+        static constexpr bool contiguous_layout = false;
+
+        template <class Func, class CTA>
+        xaccumulator(Func&& f, CTA&& e, size_type axis);
+
+        size_type size() const noexcept;
+        size_type dimension() const noexcept;
+        const inner_shape_type& shape() const noexcept;
+        layout_type layout() const noexcept;
+
+        template <class... Args>
+        const_reference operator()(Args... args) const;
+        template <class... Args>
+        const_reference at(Args... args) const;
+        template <class S>
+        disable_integral_t<S, const_reference> operator[](const S& index) const;
+        template <class I>
+        const_reference operator[](std::initializer_list<I> index) const;
+        const_reference operator[](size_type i) const;
+
+        template <class It>
+        const_reference element(It first, It last) const;
+
+        const xexpression_type& expression() const noexcept;
+        const functor_type& functor() const noexcept;
+        size_type axis() const noexcept;
+
+        template <class S>
+        bool broadcast_shape(S& shape, bool reuse_cache = false) const;
+
+        template <class S>
+        bool is_trivial_broadcast(const S& strides) const noexcept;
+
+        template <class S>
+        const_stepper stepper_begin(const S& shape) const noexcept;
+        template <class S>
+        const_stepper stepper_end(const S& shape, layout_type l) const noexcept;
+
+    private:
+
+        CT m_e;
+        functor_type m_f;
+        size_type m_axis;
+
+        friend class xaccumulator_stepper<F, CT>;
+    };
+
+    /************************
+     * xaccumulator_stepper *
+     ************************/
+
+    template <class F, class CT>
+    class xaccumulator_stepper
+    {
+    public:
+
+        using self_type = xaccumulator_stepper<F, CT>;
+        using xaccumulator_type = xaccumulator<F, CT>;
+
+        using value_type = typename xaccumulator_type::value_type;
+        using reference = typename xaccumulator_type::value_type;
+        using pointer = typename xaccumulator_type::const_pointer;
+        using size_type = typename xaccumulator_type::size_type;
+        using difference_type = typename xaccumulator_type::difference_type;
+
+        using xexpression_type = typename xaccumulator_type::xexpression_type;
+        using substepper_type = typename xexpression_type::const_stepper;
+        using shape_type = typename xaccumulator_type::shape_type;
+        using index_type = xindex_type_t<shape_type>;
+
+        xaccumulator_stepper(const xaccumulator_type& acc, size_type offset, bool end = false,
+                             layout_type l = default_assignable_layout(xexpression_type::static_layout));
+
+        reference operator*() const;
+
+        void step(size_type dim, size_type n = 1);
+        void step_back(size_type dim, size_type n = 1);
+        void reset(size_type dim);
+        void reset_back(size_type dim);
+
+        void to_begin();
+        void to_end(layout_type l);
+
+        bool equal(const self_type& rhs) const;
+
+    private:
+
+        bool moves_along(size_type dim) const noexcept;
+        void moved(size_type dim) noexcept;
+        bool is_lane_dim(size_type dim) const noexcept;
+        size_type lane() const noexcept;
+        value_type accumulate_axis() const;
+
+        const xaccumulator_type& m_acc;
+        size_type m_offset;
+        substepper_type m_stepper;
+        index_type m_index;
+        // Running accumulation of each lane, i.e. of each position in the
+        // dimensions traversed faster than the accumulated axis in the
+        // default layout, tagged with the position along the axis and the
+        // position in the dimensions traversed slower (m_slab).
+        mutable std::vector<value_type> m_values;
+        mutable std::vector<size_type> m_rows;
+        mutable std::vector<size_type> m_slabs;
+        size_type m_slab;
+    };
+
+    template <class F, class CT>
+    bool operator==(const xaccumulator_stepper<F, CT>& lhs,
+                    const xaccumulator_stepper<F, CT>& rhs);
+
+    template <class F, class CT>
+    bool operator!=(const xaccumulator_stepper<F, CT>& lhs,
+                    const xaccumulator_stepper<F, CT>& rhs);
+
     /**************
      * accumulate *
      **************/
 
     namespace detail
     {
+        // False for the strategies reaching the fallback overloads below.
+        // Being dependent, it delays their static_assert to instantiation.
+        template <class ES>
+        struct is_accumulator_strategy : std::false_type
+        {
+        };
+
+        // Evaluation strategies without an accumulator_impl overload, such
+        // as cached, keep_dims and lazy without an axis, end up here.
         template <class F, class E, class ES>
-        xarray<typename std::decay_t<E>::value_type> accumulator_impl(F&&, E&&, std::size_t, ES)
+        void accumulator_impl(F&&, E&&, std::size_t, ES)
         {
-            static_assert(!std::is_same<evaluation_strategy::lazy, ES>::value, "Lazy accumulators not yet implemented.");
+            static_assert(is_accumulator_strategy<ES>::value, "unsupported evaluation strategy for accumulators");
         }
 
         template <class F, class E, class ES>
-        xarray<typename std::decay_t<E>::value_type> accumulator_impl(F&&, E&&, ES)
+        void accumulator_impl(F&&, E&&, ES)
         {
-            static_assert(!std::is_same<evaluation_strategy::lazy, ES>::value, "Lazy accumulators not yet implemented.");
+            static_assert(is_accumulator_strategy<ES>::value, "unsupported evaluation strategy for accumulators");
         }
 
         template <class T, class R>
@@ -57,10 +507,10 @@ namespace xt
         template <class T, class R>
         using xaccumulator_return_type_t = typename xaccumulator_return_type<T, R>::type;
 
-        template <class F, class E>
-        inline auto accumulator_impl(F&& f, E&& e, std::size_t axis, evaluation_strategy::immediate)
+        template <class F, class E, class P>
+        inline auto accumulate_axis(F&& f, E&& e, std::size_t axis, P parallel)
         {
-            using function_return_type = typename F::result_type;
+            using function_return_type = typename std::decay_t<F>::result_type;
             using result_type = xaccumulator_return_type_t<std::decay_t<E>, function_return_type>;
 
             if (axis >= e.dimension())
@@ -70,67 +520,76 @@ namespace xt
 
             result_type result = e;  // assign + make a copy, we need it anyways
 
-            std::size_t inner_stride = result.strides()[axis];
-            std::size_t outer_stride = 1; // this is either going row- or column-wise (strides.back / strides.front)
-            std::size_t outer_loop_size = 0;
-            std::size_t inner_loop_size = 0;
-
-            auto set_loop_sizes = [&outer_loop_size, &inner_loop_size](auto first, auto last, ptrdiff_t ax)
+            // The result is split in outer blocks of n slabs of s contiguous
+            // elements, n being the size of the accumulated axis.
+            const auto& shape = result.shape();
+            auto first = shape.cbegin();
+            auto ax = first + static_cast<std::ptrdiff_t>(axis);
+            std::size_t n = *ax;
+            std::size_t outer = std::accumulate(first, ax, std::size_t(1), std::multiplies<std::size_t>());
+            std::size_t s = std::accumulate(ax + 1, shape.cend(), std::size_t(1), std::multiplies<std::size_t>());
+            if (result_type::static_layout != layout_type::row_major)
             {
-                outer_loop_size = std::accumulate(first,
-                                                  first + ax,
-                                                  std::size_t(1), std::multiplies<std::size_t>());
-
-                inner_loop_size = std::accumulate(first + ax,
-                                                  last,
-                                                  std::size_t(1), std::multiplies<std::size_t>());
-            };
-
-            if (result_type::static_layout == layout_type::row_major)
-            {
-                set_loop_sizes(result.shape().cbegin(), result.shape().cend(), static_cast<ptrdiff_t>(axis));
-            }
-            else
-            {
-                set_loop_sizes(result.shape().cbegin(), result.shape().cend(), static_cast<ptrdiff_t>(axis + 1));
-                std::swap(inner_loop_size, outer_loop_size);
+                std::swap(outer, s);
             }
-            inner_loop_size = inner_loop_size - inner_stride;
 
-            std::size_t pos = 0;
-            for (std::size_t i = 0; i < outer_loop_size; ++i)
+            if (result.size() != 0)
             {
-                for (std::size_t j = 0; j < inner_loop_size; ++j)
-                {
-                    result.data()[pos + inner_stride] = f(result.data()[pos],
-                                                          result.data()[pos + inner_stride]);
-                    pos += outer_stride;
-                }
-                pos += inner_stride;
+                scan_data(f, result.raw_data(), outer, n, s, parallel);
             }
             return result;
         }
 
-        template <class F, class E>
-        inline auto accumulator_impl(F&& f, E&& e, evaluation_strategy::immediate)
+        template <class F, class E, class P>
+        inline auto accumulate_flat(F&& f, E&& e, P parallel)
         {
-            using T = typename F::result_type;
+            using T = typename std::decay_t<F>::result_type;
             using result_type = xtensor<T, 1>;
             std::size_t sz = e.size();
             auto result = result_type::from_shape({sz});
 
-            auto it = e.template begin<DEFAULT_LAYOUT>();
-
-            result.data()[0] = *it;
-            ++it;
-
-            for (std::size_t idx = 0; it != e.template end<DEFAULT_LAYOUT>(); ++it)
+            std::copy(e.template begin<DEFAULT_LAYOUT>(), e.template end<DEFAULT_LAYOUT>(), result.begin());
+            if (sz != 0)
             {
-                result.data()[idx + 1] = f(result.data()[idx], *it);
-                ++idx;
+                scan_data(f, result.raw_data(), std::size_t(1), sz, std::size_t(1), parallel);
             }
             return result;
         }
+
+        template <class F, class E>
+        inline auto accumulator_impl(F&& f, E&& e, std::size_t axis, evaluation_strategy::lazy)
+        {
+            if (axis >= e.dimension())
+            {
+                throw std::runtime_error("Axis larger than expression dimension in accumulator.");
+            }
+            using accumulator_type = xaccumulator<std::decay_t<F>, const_xclosure_t<E>>;
+            return accumulator_type(std::forward<F>(f), std::forward<E>(e), axis);
+        }
+
+        template <class F, class E>
+        inline auto accumulator_impl(F&& f, E&& e, std::size_t axis, evaluation_strategy::immediate)
+        {
+            return accumulate_axis(std::forward<F>(f), std::forward<E>(e), axis, std::false_type());
+        }
+
+        template <class F, class E>
+        inline auto accumulator_impl(F&& f, E&& e, evaluation_strategy::immediate)
+        {
+            return accumulate_flat(std::forward<F>(f), std::forward<E>(e), std::false_type());
+        }
+
+        template <class F, class E>
+        inline auto accumulator_impl(F&& f, E&& e, std::size_t axis, evaluation_strategy::parallel)
+        {
+            return accumulate_axis(std::forward<F>(f), std::forward<E>(e), axis, std::true_type());
+        }
+
+        template <class F, class E>
+        inline auto accumulator_impl(F&& f, E&& e, evaluation_strategy::parallel)
+        {
+            return accumulate_flat(std::forward<F>(f), std::forward<E>(e), std::true_type());
+        }
     }
 
     /**
@@ -139,7 +598,8 @@ namespace xt
      *
      * @param f functor to use for accumulation
      * @param e xexpression to be accumulated
-     * @param evaluation_strategy evaluation strategy of the accumulation
+     * @param evaluation_strategy evaluation strategy of the accumulation, immediate (default)
+     * or parallel
      *
      * @return returns xarray<T> filled with accumulated values
      */
@@ -154,14 +614,16 @@ namespace xt
 
     /**
      * Accumulate over axis
-     * **NOTE** This function is not lazy!
+     * **NOTE** This function is not lazy unless the lazy evaluation strategy is selected!
      *
      * @param f Functor to use for accumulation
      * @param e xexpression to accumulate
      * @param axis Axis to perform accumulation over
-     * @param evaluation_strategy evaluation strategy of the accumulation
+     * @param evaluation_strategy evaluation strategy of the accumulation, immediate (default),
+     * parallel or lazy
      *
-     * @return returns xarray<T> filled with accumulated values
+     * @return returns xarray<T> filled with accumulated values, or an \ref xaccumulator
+     * with the lazy evaluation strategy
      */
     template <class F, class E, class ES = DEFAULT_STRATEGY_ACCUMULATORS>
     inline auto accumulate(F&& f, E&& e, std::size_t axis, ES evaluation_strategy = ES())
@@ -169,6 +631,433 @@ namespace xt
         return detail::accumulator_impl(std::forward<F>(f), std::forward<E>(e), axis, evaluation_strategy);
     }
 
+    /*******************************
+     * xaccumulator implementation *
+     *******************************/
+
+    /**
+     * @name Constructor
+     */
+    //@{
+    /**
+     * Constructs an xaccumulator expression accumulating the specified
+     * expression along the given axis.
+     *
+     * @param f the accumulating functor
+     * @param e the expression to accumulate
+     * @param axis the axis along which the expression is accumulated
+     */
+    template <class F, class CT>
+    template <class Func, class CTA>
+    inline xaccumulator<F, CT>::xaccumulator(Func&& f, CTA&& e, size_type axis)
+        : m_e(std::forward<CTA>(e)), m_f(std::forward<Func>(f)), m_axis(axis)
+    {
+    }
+    //@}
+
+    /**
+     * @name Size and shape
+     */
+    //@{
+    /**
+     * Returns the size of the expression.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::size() const noexcept -> size_type
+    {
+        return compute_size(shape());
+    }
+
+    /**
+     * Returns the number of dimensions of the expression.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::dimension() const noexcept -> size_type
+    {
+        return m_e.dimension();
+    }
+
+    /**
+     * Returns the shape of the expression.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::shape() const noexcept -> const inner_shape_type&
+    {
+        return m_e.shape();
+    }
+
+    /**
+     * Returns the layout of the expression.
+     */
+    template <class F, class CT>
+    inline layout_type xaccumulator<F, CT>::layout() const noexcept
+    {
+        return m_e.layout();
+    }
+    //@}
+
+    /**
+     * @name Data
+     */
+    //@{
+    /**
+     * Returns a constant reference to the element at the specified position in the expression.
+     * @param args a list of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices should be equal or greater than
+     * the number of dimensions of the expression.
+     */
+    template <class F, class CT>
+    template <class... Args>
+    inline auto xaccumulator<F, CT>::operator()(Args... args) const -> const_reference
+    {
+        std::array<size_type, sizeof...(Args)> index = {{static_cast<size_type>(args)...}};
+        return element(index.cbegin(), index.cend());
+    }
+
+    /**
+     * Returns a constant reference to the element at the specified position in the expression,
+     * after dimension and bounds checking.
+     * @param args a list of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices should be equal to the number of dimensions
+     * of the expression.
+     * @exception std::out_of_range if the number of argument is greater than the number of dimensions
+     * or if indices are out of bounds.
+     */
+    template <class F, class CT>
+    template <class... Args>
+    inline auto xaccumulator<F, CT>::at(Args... args) const -> const_reference
+    {
+        check_access(shape(), static_cast<size_type>(args)...);
+        return this->operator()(args...);
+    }
+
+    /**
+     * Returns a constant reference to the element at the specified position in the expression.
+     * @param index a sequence of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices in the sequence should be equal or greater
+     * than the number of dimensions of the expression.
+     */
+    template <class F, class CT>
+    template <class S>
+    inline auto xaccumulator<F, CT>::operator[](const S& index) const
+        -> disable_integral_t<S, const_reference>
+    {
+        return element(index.cbegin(), index.cend());
+    }
+
+    template <class F, class CT>
+    template <class I>
+    inline auto xaccumulator<F, CT>::operator[](std::initializer_list<I> index) const
+        -> const_reference
+    {
+        return element(index.begin(), index.end());
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::operator[](size_type i) const -> const_reference
+    {
+        return operator()(i);
+    }
+
+    /**
+     * Returns a constant reference to the element at the specified position in the expression.
+     * @param first iterator starting the sequence of indices
+     * @param last iterator ending the sequence of indices
+     * The number of indices in the sequence should be equal to or greater
+     * than the number of dimensions of the expression.
+     */
+    template <class F, class CT>
+    template <class It>
+    inline auto xaccumulator<F, CT>::element(It first, It last) const -> const_reference
+    {
+        using index_type = xindex_type_t<shape_type>;
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        index_type index = xtl::make_sequence<index_type>(dimension(), size_type(0));
+        std::copy(std::next(first, static_cast<difference_type>(n - dimension())), last, index.begin());
+
+        size_type k = index[m_axis];
+        index[m_axis] = 0;
+        value_type res = m_e.element(index.cbegin(), index.cend());
+        for (size_type i = 1; i <= k; ++i)
+        {
+            index[m_axis] = i;
+            res = m_f(res, m_e.element(index.cbegin(), index.cend()));
+        }
+        return res;
+    }
+
+    /**
+     * Returns a constant reference to the underlying expression of the accumulator.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::expression() const noexcept -> const xexpression_type&
+    {
+        return m_e;
+    }
+
+    /**
+     * Returns the accumulating functor.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::functor() const noexcept -> const functor_type&
+    {
+        return m_f;
+    }
+
+    /**
+     * Returns the axis along which the expression is accumulated.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::axis() const noexcept -> size_type
+    {
+        return m_axis;
+    }
+    //@}
+
+    /**
+     * @name Broadcasting
+     */
+    //@{
+    /**
+     * Broadcast the shape of the accumulator to the specified parameter.
+     * @param shape the result shape
+     * @param reuse_cache parameter for internal optimization
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class F, class CT>
+    template <class S>
+    inline bool xaccumulator<F, CT>::broadcast_shape(S& shape, bool) const
+    {
+        return xt::broadcast_shape(this->shape(), shape);
+    }
+
+    /**
+     * Compares the specified strides with those of the container to see whether
+     * the broadcasting is trivial.
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class F, class CT>
+    template <class S>
+    inline bool xaccumulator<F, CT>::is_trivial_broadcast(const S& /*strides*/) const noexcept
+    {
+        return false;
+    }
+    //@}
+
+    template <class F, class CT>
+    template <class S>
+    inline auto xaccumulator<F, CT>::stepper_begin(const S& shape) const noexcept -> const_stepper
+    {
+        size_type offset = shape.size() - dimension();
+        return const_stepper(*this, offset);
+    }
+
+    template <class F, class CT>
+    template <class S>
+    inline auto xaccumulator<F, CT>::stepper_end(const S& shape, layout_type l) const noexcept -> const_stepper
+    {
+        size_type offset = shape.size() - dimension();
+        return const_stepper(*this, offset, true, l);
+    }
+
+    /***************************************
+     * xaccumulator_stepper implementation *
+     ***************************************/
+
+    template <class F, class CT>
+    inline xaccumulator_stepper<F, CT>::xaccumulator_stepper(const xaccumulator_type& acc, size_type offset, bool end, layout_type l)
+        : m_acc(acc), m_offset(offset),
+          m_stepper(acc.m_e.stepper_begin(acc.m_e.shape())),
+          m_index(xtl::make_sequence<index_type>(acc.dimension(), size_type(0))),
+          m_slab(0)
+    {
+        if (end)
+        {
+            to_end(l);
+        }
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator_stepper<F, CT>::operator*() const -> reference
+    {
+        if (m_values.empty())
+        {
+            const auto& shape = m_acc.shape();
+            size_type n_lanes = 1;
+            for (size_type d = 0; d < shape.size(); ++d)
+            {
+                n_lanes *= is_lane_dim(d) ? shape[d] : size_type(1);
+            }
+            m_values.resize(n_lanes);
+            m_rows.resize(n_lanes);
+            m_slabs.resize(n_lanes, std::numeric_limits<size_type>::max());
+        }
+
+        size_type l = lane();
+        size_type k = m_index[m_acc.m_axis];
+        if (m_slabs[l] == m_slab && m_rows[l] == k)
+        {
+            return m_values[l];
+        }
+
+        value_type res;
+        if (k != 0 && m_slabs[l] == m_slab && m_rows[l] + 1 == k)
+        {
+            res = m_acc.m_f(m_values[l], *m_stepper);
+        }
+        else
+        {
+            res = accumulate_axis();
+        }
+        m_values[l] = res;
+        m_rows[l] = k;
+        m_slabs[l] = m_slab;
+        return res;
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::step(size_type dim, size_type n)
+    {
+        if (moves_along(dim))
+        {
+            m_stepper.step(dim - m_offset, n);
+            m_index[dim - m_offset] += n;
+            moved(dim - m_offset);
+        }
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::step_back(size_type dim, size_type n)
+    {
+        if (moves_along(dim))
+        {
+            m_stepper.step_back(dim - m_offset, n);
+            m_index[dim - m_offset] -= n;
+            moved(dim - m_offset);
+        }
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::reset(size_type dim)
+    {
+        if (moves_along(dim))
+        {
+            m_stepper.reset(dim - m_offset);
+            m_index[dim - m_offset] = 0;
+            moved(dim - m_offset);
+        }
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::reset_back(size_type dim)
+    {
+        if (moves_along(dim))
+        {
+            m_stepper.reset_back(dim - m_offset);
+            m_index[dim - m_offset] = m_acc.shape()[dim - m_offset] - 1;
+            moved(dim - m_offset);
+        }
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::to_begin()
+    {
+        m_stepper.to_begin();
+        std::fill(m_index.begin(), m_index.end(), size_type(0));
+        ++m_slab;
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::to_end(layout_type l)
+    {
+        m_stepper.to_end(l);
+        // Mirrors the index of an end iterator
+        const auto& shape = m_acc.shape();
+        std::transform(shape.cbegin(), shape.cend(), m_index.begin(), [](size_type s) { return s - 1; });
+        if (!m_index.empty())
+        {
+            size_type inner = l == layout_type::row_major ? m_index.size() - 1 : 0;
+            ++m_index[inner];
+        }
+        ++m_slab;
+    }
+
+    template <class F, class CT>
+    inline bool xaccumulator_stepper<F, CT>::equal(const self_type& rhs) const
+    {
+        return &m_acc == &(rhs.m_acc) && m_stepper.equal(rhs.m_stepper);
+    }
+
+    template <class F, class CT>
+    inline bool xaccumulator_stepper<F, CT>::moves_along(size_type dim) const noexcept
+    {
+        // Dimensions added by broadcasting and dimensions of size 1 broadcast
+        // against a larger shape are ignored: the index must stay in the shape
+        // of the accumulator, as the stride of the underlying expression does.
+        return dim >= m_offset && m_acc.shape()[dim - m_offset] != 1;
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::moved(size_type dim) noexcept
+    {
+        // Moving along a dimension traversed slower than the axis starts a
+        // new slab, the running accumulations of the lanes are outdated
+        if (dim != m_acc.m_axis && !is_lane_dim(dim))
+        {
+            ++m_slab;
+        }
+    }
+
+    template <class F, class CT>
+    inline bool xaccumulator_stepper<F, CT>::is_lane_dim(size_type dim) const noexcept
+    {
+        return DEFAULT_LAYOUT == layout_type::row_major ? dim > m_acc.m_axis : dim < m_acc.m_axis;
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator_stepper<F, CT>::lane() const noexcept -> size_type
+    {
+        const auto& shape = m_acc.shape();
+        size_type res = 0;
+        for (size_type d = 0; d < shape.size(); ++d)
+        {
+            if (is_lane_dim(d))
+            {
+                res = res * shape[d] + m_index[d];
+            }
+        }
+        return res;
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator_stepper<F, CT>::accumulate_axis() const -> value_type
+    {
+        size_type axis = m_acc.m_axis;
+        size_type k = m_index[axis];
+        substepper_type st = m_stepper;
+        st.step_back(axis, k);
+        value_type res = *st;
+        for (size_type i = 0; i < k; ++i)
+        {
+            st.step(axis);
+            res = m_acc.m_f(res, *st);
+        }
+        return res;
+    }
+
+    template <class F, class CT>
+    inline bool operator==(const xaccumulator_stepper<F, CT>& lhs,
+                           const xaccumulator_stepper<F, CT>& rhs)
+    {
+        return lhs.equal(rhs);
+    }
+
+    template <class F, class CT>
+    inline bool operator!=(const xaccumulator_stepper<F, CT>& lhs,
+                           const xaccumulator_stepper<F, CT>& rhs)
+    {
+        return !(lhs.equal(rhs));
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -10,12 +10,24 @@
 #define XTENSOR_ASSIGN_HPP
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+#if defined(XTENSOR_USE_XSIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define XTENSOR_STREAMING_STORES
+#endif
 
 #include "xtl/xsequence.hpp"
 
+#include "xassign_stats.hpp"
 #include "xconcepts.hpp"
 #include "xexpression.hpp"
 #include "xiterator.hpp"
+#include "xparallel.hpp"
 #include "xtensor_forward.hpp"
 #include "xutils.hpp"
 
@@ -82,6 +94,42 @@ namespace xt
         static bool resize(xexpression<E1>& e1, const xexpression<E2>& e2);
     };
 
+    /**********************
+     * simd_assign_traits *
+     **********************/
+
+    namespace detail
+    {
+        template <class T>
+        using is_simd_convertible = std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>;
+
+        /**
+         * Selects the value type of the simd batches used to assign an
+         * expression of type E2 to a container of type E1. Conversions
+         * happen in the rhs batch type, which is converted while being
+         * stored. If the rhs value type has no simd batch but the rhs
+         * is a container, its values are converted while being loaded
+         * in a batch of the lhs value type.
+         */
+        template <class E1, class E2>
+        struct simd_assign_traits
+        {
+            using lhs_value_type = typename E1::value_type;
+            using rhs_value_type = typename E2::value_type;
+
+            static constexpr bool same_type = std::is_same<lhs_value_type, rhs_value_type>::value;
+            static constexpr bool convertible_types = is_simd_convertible<lhs_value_type>::value &&
+                                                      is_simd_convertible<rhs_value_type>::value;
+            static constexpr bool lhs_simd = xsimd::simd_traits<lhs_value_type>::size > 1;
+            static constexpr bool rhs_simd = xsimd::simd_traits<rhs_value_type>::size > 1;
+            static constexpr bool load_conversion = !rhs_simd && has_raw_data_interface<E2>::value;
+
+            static constexpr bool value = same_type ? lhs_simd : (convertible_types && lhs_simd && (rhs_simd || load_conversion));
+
+            using value_type = std::conditional_t<rhs_simd, rhs_value_type, lhs_value_type>;
+        };
+    }
+
     /*****************
      * data_assigner *
      *****************/
@@ -109,6 +157,22 @@ namespace xt
 
     private:
 
+        using simd_traits = detail::simd_assign_traits<E1, E2>;
+        using simd_type = xsimd::simd_type<typename E2::value_type>;
+        static constexpr bool simd_step = simd_traits::value && simd_traits::rhs_simd &&
+                                          detail::has_simd_step<lhs_iterator, simd_type>::value &&
+                                          detail::has_simd_step<rhs_iterator, simd_type>::value;
+
+        static constexpr bool merge_step = detail::has_equivalent_step<lhs_iterator>::value &&
+                                           detail::has_equivalent_step<rhs_iterator>::value;
+
+        size_type merge_inner_dimensions(size_type inner, std::true_type) const;
+        size_type merge_inner_dimensions(size_type inner, std::false_type) const;
+        bool is_simd_row(size_type dim, size_type n, std::true_type);
+        bool is_simd_row(size_type dim, size_type n, std::false_type);
+        size_type assign_simd_row(size_type dim, size_type n, std::true_type);
+        size_type assign_simd_row(size_type dim, size_type n, std::false_type);
+
         E1& m_e1;
 
         lhs_iterator m_lhs;
@@ -129,6 +193,86 @@ namespace xt
         static void run(E1& e1, const E2& e2);
     };
 
+    /******************
+     * memory_overlap *
+     ******************/
+
+    template <class CT, class S, class CD>
+    class xstrided_view;
+
+    template <class F, class R, class... CT>
+    class xfunction;
+
+    namespace detail
+    {
+        enum class overlap_type
+        {
+            none,
+            elementwise,
+            unsafe
+        };
+
+        template <class E, class = void>
+        struct has_flat_storage : std::false_type
+        {
+        };
+
+        template <class E>
+        struct has_flat_storage<E, void_t<decltype(std::declval<const E&>().data().data())>> : std::true_type
+        {
+        };
+
+        /**
+         * True for strided expressions whose elements are stored in a flat
+         * buffer read through raw_data(). Optional containers store their
+         * values and flags in separate buffers and are excluded.
+         */
+        template <class E>
+        struct has_memory_span : std::integral_constant<bool, has_raw_data_interface<E>::value &&
+                                                             !is_xoptional_expression<E>::value &&
+                                                             has_flat_storage<E>::value>
+        {
+        };
+
+        template <class CT, class S, class CD>
+        struct has_memory_span<xstrided_view<CT, S, CD>> : has_memory_span<std::decay_t<CT>>
+        {
+        };
+
+        template <class E1, class E2>
+        overlap_type memory_overlap(const E1& e1, const E2& e2);
+
+        template <class E1, class E2>
+        bool has_same_broadcast_shape(const E1& e1, const E2& e2);
+    }
+
+    /********************
+     * blocked_assigner *
+     ********************/
+
+    /**
+     * Assigns strided expressions whose innermost dimensions differ,
+     * such as a transposed container, by tiles fitting in the caches.
+     */
+    struct blocked_assigner
+    {
+        template <class E1, class E2>
+        static bool run(E1& e1, const E2& e2);
+
+    private:
+
+        template <class E1, class E2>
+        static bool run_impl(E1& e1, const E2& e2, std::true_type);
+
+        template <class E1, class E2>
+        static bool run_impl(E1& e1, const E2& e2, std::false_type);
+
+        template <class T1, class T2>
+        static void assign_tiles(T1* lhs, const T2* rhs, std::size_t n_inner, std::size_t n_outer,
+                                 std::ptrdiff_t lhs_inner, std::ptrdiff_t lhs_outer,
+                                 std::ptrdiff_t rhs_inner, std::ptrdiff_t rhs_outer);
+    };
+
     /***********************************
      * Assign functions implementation *
      ***********************************/
@@ -207,20 +351,28 @@ namespace xt
         E1& de1 = e1.derived_cast();
         const E2& de2 = e2.derived_cast();
 
+        std::size_t size = de1.size();
+        detail::xassign_recorder recorder(size, size * sizeof(typename E1::value_type));
+
         bool trivial_broadcast = trivial && detail::is_trivial_broadcast(de1, de2);
         if (trivial_broadcast)
         {
             constexpr bool contiguous_layout = E1::contiguous_layout && E2::contiguous_layout;
-            constexpr bool same_type = std::is_same<typename E1::value_type, typename E2::value_type>::value;
-            constexpr bool simd_size = xsimd::simd_traits<typename E1::value_type>::size > 1;
+            constexpr bool simd_types = detail::simd_assign_traits<E1, E2>::value;
             constexpr bool forbid_simd = detail::forbid_simd_assign<E2>::value;
-            constexpr bool simd_assign = contiguous_layout && same_type && simd_size && !forbid_simd;
+            constexpr bool simd_assign = contiguous_layout && simd_types && !forbid_simd;
             trivial_assigner<simd_assign>::run(de1, de2);
+            recorder.record(simd_assign ? assign_path::simd_trivial : assign_path::scalar_trivial);
+        }
+        else if (blocked_assigner::run(de1, de2))
+        {
+            recorder.record(assign_path::blocked);
         }
         else
         {
             data_assigner<E1, E2, default_assignable_layout(E1::static_layout)> assigner(de1, de2);
             assigner.run();
+            recorder.record(assign_path::stepper);
         }
     }
 
@@ -249,6 +401,7 @@ namespace xt
         if (dim > de1.dimension() || shape > de1.shape())
         {
             typename E1::temporary_type tmp(shape);
+            detail::record_temporary(tmp.size() * sizeof(typename E1::value_type));
             base_type::assign_data(tmp, e2, trivial_broadcast);
             de1.assign_temporary(std::move(tmp));
         }
@@ -317,11 +470,126 @@ namespace xt
         using result_type = std::decay_t<decltype(*m_lhs)>;
         constexpr bool is_narrowing = is_narrowing_conversion<argument_type, result_type>::value;
 
-        while (m_rhs != m_rhs_end)
+        const auto& shape = m_e1.shape();
+        if (shape.size() == 0)
+        {
+            while (m_rhs != m_rhs_end)
+            {
+                *m_lhs = conditional_cast<is_narrowing, result_type>(*m_rhs);
+                stepper_tools<L>::increment_stepper(*this, m_index, shape);
+            }
+            return;
+        }
+
+        size_type size = m_e1.size();
+        if (size == 0)
         {
+            return;
+        }
+
+        // The innermost dimensions that can be traversed by stepping along the
+        // innermost one only are merged into rows. Rows are traversed in a tight
+        // loop, the index and the outer dimensions of the steppers are updated
+        // once per row.
+        size_type inner = L == layout_type::row_major ? shape.size() - 1 : 0;
+        size_type n_merged = merge_inner_dimensions(inner, std::integral_constant<bool, merge_step>());
+        size_type row_begin = L == layout_type::row_major ? shape.size() - n_merged : 0;
+        size_type row_end = row_begin + n_merged;
+        size_type row_size = std::accumulate(shape.cbegin() + std::ptrdiff_t(row_begin), shape.cbegin() + std::ptrdiff_t(row_end),
+                                             size_type(1), std::multiplies<size_type>());
+        size_type n_rows = size / row_size;
+        using simd_step_type = std::integral_constant<bool, simd_step>;
+        bool simd_row = is_simd_row(inner, row_size, simd_step_type());
+
+        for (size_type row = 0; row < n_rows; ++row)
+        {
+            size_type i = simd_row ? assign_simd_row(inner, row_size, simd_step_type()) : 0;
+            for (; i + 1 < row_size; ++i)
+            {
+                *m_lhs = conditional_cast<is_narrowing, result_type>(*m_rhs);
+                m_lhs.step(inner);
+                m_rhs.step(inner);
+            }
             *m_lhs = conditional_cast<is_narrowing, result_type>(*m_rhs);
-            stepper_tools<L>::increment_stepper(*this, m_index, m_e1.shape());
+            for (size_type d = row_begin; d < row_end; ++d)
+            {
+                m_index[d] = shape[d] - 1;
+            }
+            stepper_tools<L>::increment_stepper(*this, m_index, shape);
+        }
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline auto data_assigner<E1, E2, L>::merge_inner_dimensions(size_type inner, std::true_type) const -> size_type
+    {
+        // An outer dimension is merged with the row if stepping once along it
+        // is equivalent to stepping row_size times along the innermost one,
+        // for the lhs and all the leaves of the rhs.
+        const auto& shape = m_e1.shape();
+        size_type row_size = shape[inner];
+        size_type n_merged = 1;
+        for (; n_merged < shape.size(); ++n_merged)
+        {
+            size_type outer = L == layout_type::row_major ? inner - n_merged : inner + n_merged;
+            bool mergeable = shape[outer] == 1 ||
+                             (m_lhs.is_equivalent_step(outer, 1, inner, row_size) &&
+                              m_rhs.is_equivalent_step(outer, 1, inner, row_size));
+            if (!mergeable)
+            {
+                break;
+            }
+            row_size *= shape[outer];
+        }
+        return n_merged;
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline auto data_assigner<E1, E2, L>::merge_inner_dimensions(size_type, std::false_type) const -> size_type
+    {
+        return 1;
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline bool data_assigner<E1, E2, L>::is_simd_row(size_type dim, size_type n, std::true_type)
+    {
+        if (n <= simd_type::size || !m_lhs.has_linear_step(dim) || !m_rhs.has_linear_step(dim))
+        {
+            return false;
         }
+        // The lhs must not be broadcast along dim
+        auto* p = &(*m_lhs);
+        m_lhs.step(dim);
+        bool res = &(*m_lhs) == p + 1;
+        m_lhs.step_back(dim);
+        return res;
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline bool data_assigner<E1, E2, L>::is_simd_row(size_type, size_type, std::false_type)
+    {
+        return false;
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline auto data_assigner<E1, E2, L>::assign_simd_row(size_type dim, size_type n, std::true_type) -> size_type
+    {
+        using value_type = typename E1::value_type;
+        size_type simd_size = simd_type::size;
+        size_type i = 0;
+        // The last element of the row is left to the scalar loop so the
+        // steppers never move past the end of the row.
+        for (; i + simd_size < n; i += simd_size)
+        {
+            xsimd::store_simd<value_type, typename simd_type::value_type>(&(*m_lhs), m_rhs.template step_simd<simd_type>(dim), xsimd::unaligned_mode());
+            m_lhs.step(dim, simd_size);
+        }
+        return i;
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline auto data_assigner<E1, E2, L>::assign_simd_row(size_type, size_type, std::false_type) -> size_type
+    {
+        return 0;
     }
 
     template <class E1, class E2, layout_type L>
@@ -349,44 +617,156 @@ namespace xt
      * trivial_assigner implementation *
      ***********************************/
 
+    namespace assigner_detail
+    {
+#ifdef XTENSOR_STREAMING_STORES
+        constexpr bool has_streaming_stores = true;
+#else
+        constexpr bool has_streaming_stores = false;
+#endif
+
+        /**
+         * Copies \c size bytes from \c src to \c dst with non-temporal
+         * stores, which do not read the destination cache lines. \c dst
+         * must be aligned on 16 bytes and \c size be a multiple of 16.
+         */
+        inline void stream_copy(void* dst, const void* src, std::size_t size) noexcept
+        {
+#ifdef XTENSOR_STREAMING_STORES
+            __m128i* d = static_cast<__m128i*>(dst);
+            const __m128i* s = static_cast<const __m128i*>(src);
+            for (std::size_t i = 0; i < size / 16; ++i)
+            {
+                _mm_stream_si128(d + i, _mm_load_si128(s + i));
+            }
+#else
+            std::memcpy(dst, src, size);
+#endif
+        }
+
+        inline void stream_fence() noexcept
+        {
+#ifdef XTENSOR_STREAMING_STORES
+            _mm_sfence();
+#endif
+        }
+
+        /**
+         * Assigns the elements [first, last) of e2 to e1 through a small
+         * buffer that stays in L1 and is flushed with non-temporal stores.
+         * The destination of the first element must be aligned on 16 bytes,
+         * and last - first be a multiple of the simd size.
+         */
+        template <class rhs_align_mode, class simd_type, class E1, class E2>
+        inline void stream_assign(E1& e1, const E2& e2, std::size_t first, std::size_t last)
+        {
+            using value_type = typename E1::value_type;
+            constexpr std::size_t simd_size = simd_type::size;
+            constexpr std::size_t buffer_size = std::max(std::size_t(4096) / sizeof(value_type) / simd_size, std::size_t(1)) * simd_size;
+            alignas(64) value_type buffer[buffer_size];
+            for (std::size_t i = first; i < last; i += buffer_size)
+            {
+                std::size_t n = std::min(buffer_size, last - i);
+                for (std::size_t j = 0; j < n; j += simd_size)
+                {
+                    xsimd::store_simd<value_type, typename simd_type::value_type>(buffer + j, e2.template load_simd<rhs_align_mode, simd_type>(i + j), aligned_mode());
+                }
+                stream_copy(std::addressof(e1.data_element(i)), buffer, n * sizeof(value_type));
+            }
+            stream_fence();
+        }
+    }
+
     template <bool simd_assign>
     template <class E1, class E2>
     inline void trivial_assigner<simd_assign>::run(E1& e1, const E2& e2)
     {
-        using lhs_align_mode = xsimd::container_alignment_t<E1>;
+        // Containers of different value types do not share their alignment,
+        // the mixed type case uses unaligned loads and stores.
+        using traits = detail::simd_assign_traits<E1, E2>;
+        using lhs_align_mode = std::conditional_t<traits::same_type, xsimd::container_alignment_t<E1>, unaligned_mode>;
         constexpr bool is_aligned = std::is_same<lhs_align_mode, aligned_mode>::value;
         using rhs_align_mode = std::conditional_t<is_aligned, inner_aligned_mode, unaligned_mode>;
-        using value_type = std::common_type_t<typename E1::value_type, typename E2::value_type>;
-        using simd_type = xsimd::simd_type<value_type>;
+        using simd_type = xsimd::simd_type<typename traits::value_type>;
         using size_type = typename E1::size_type;
         size_type size = e1.size();
         size_type simd_size = simd_type::size;
 
-        size_type align_begin = is_aligned ? 0 : xsimd::get_alignment_offset(e1.raw_data(), size, simd_size);
+        size_type align_begin = (is_aligned || !traits::same_type) ? 0 : xsimd::get_alignment_offset(e1.raw_data(), size, simd_size);
         size_type align_end = align_begin + ((size - align_begin) & ~(simd_size - 1));
 
         for (size_type i = 0; i < align_begin; ++i)
         {
-            e1.data_element(i) = e2.data_element(i);
-        }
-        for (size_type i = align_begin; i < align_end; i += simd_size)
-        {
-            e1.template store_simd<lhs_align_mode, simd_type>(i, e2.template load_simd<rhs_align_mode, simd_type>(i));
+            e1.data_element(i) = static_cast<typename E1::value_type>(e2.data_element(i));
         }
+
+        // Outputs larger than the caches are written with streaming stores,
+        // saving the reads of the destination cache lines.
+        using lhs_value_type = typename E1::value_type;
+        bool stream = assigner_detail::has_streaming_stores &&
+                      size * sizeof(lhs_value_type) >= std::size_t(XTENSOR_STREAMING_STORE_THRESHOLD) &&
+                      (simd_size * sizeof(lhs_value_type)) % 16 == 0 &&
+                      reinterpret_cast<std::uintptr_t>(e1.raw_data() + align_begin) % 16 == 0;
+
+        size_type block_grain = std::max(size_type(XTENSOR_PARALLEL_GRAIN_SIZE) / simd_size, size_type(1));
+        detail::parallel_for(0, (align_end - align_begin) / simd_size, block_grain,
+                             [&e1, &e2, align_begin, simd_size, stream](std::size_t first, std::size_t last) {
+            size_type block_begin = align_begin + first * simd_size;
+            size_type block_end = align_begin + last * simd_size;
+            if (stream)
+            {
+                assigner_detail::stream_assign<rhs_align_mode, simd_type>(e1, e2, block_begin, block_end);
+                return;
+            }
+            for (size_type i = block_begin; i < block_end; i += simd_size)
+            {
+                e1.template store_simd<lhs_align_mode, simd_type>(i, e2.template load_simd<rhs_align_mode, simd_type>(i));
+            }
+        });
         for (size_type i = align_end; i < size; ++i)
         {
-            e1.data_element(i) = e2.data_element(i);
+            e1.data_element(i) = static_cast<typename E1::value_type>(e2.data_element(i));
         }
     }
 
     namespace assigner_detail
     {
+        template <class It>
+        using is_random_access_iterator = std::is_base_of<std::random_access_iterator_tag,
+                                                          typename std::iterator_traits<It>::iterator_category>;
+
         template <class E1, class E2>
-        inline void trivial_assigner_run_impl(E1& e1, const E2& e2, std::true_type)
+        inline void trivial_transform(E1& e1, const E2& e2, std::false_type)
         {
             std::transform(e2.storage_cbegin(), e2.storage_cend(), e1.storage_begin(), [](typename E2::value_type x) { return static_cast<typename E1::value_type>(x); });
         }
 
+        template <class E1, class E2>
+        inline void trivial_transform(E1& e1, const E2& e2, std::true_type)
+        {
+            detail::parallel_for(0, e1.size(), XTENSOR_PARALLEL_GRAIN_SIZE, [&e1, &e2](std::size_t first, std::size_t last) {
+                using difference_type = typename std::iterator_traits<decltype(e2.storage_cbegin())>::difference_type;
+                auto src = std::next(e2.storage_cbegin(), static_cast<difference_type>(first));
+                auto src_end = std::next(src, static_cast<difference_type>(last - first));
+                auto dst = std::next(e1.storage_begin(), static_cast<std::ptrdiff_t>(first));
+                std::transform(src, src_end, dst, [](typename E2::value_type x) { return static_cast<typename E1::value_type>(x); });
+            });
+        }
+
+        template <class E1, class E2>
+        inline void trivial_assigner_run_impl(E1& e1, const E2& e2, std::true_type)
+        {
+#ifdef XTENSOR_USE_THREADS
+            using lhs_iterator = decltype(e1.storage_begin());
+            using rhs_iterator = decltype(e2.storage_cbegin());
+            using is_random_access = xtl::conjunction<is_random_access_iterator<lhs_iterator>,
+                                                      is_random_access_iterator<rhs_iterator>>;
+            trivial_transform(e1, e2, is_random_access());
+#else
+            trivial_transform(e1, e2, std::false_type());
+#endif
+        }
+
         template <class E1, class E2>
         inline void trivial_assigner_run_impl(E1&, const E2&, std::false_type)
         {
@@ -406,6 +786,334 @@ namespace xt
         // empty in this case.
         assigner_detail::trivial_assigner_run_impl(e1, e2, is_convertible());
     }
+
+    /***********************************
+     * blocked_assigner implementation *
+     ***********************************/
+
+    namespace detail
+    {
+        /**
+         * Returns the largest power of two n such that a tile of n x n
+         * elements of type T and the tile it is assigned to fit in
+         * a cache of the given size.
+         */
+        template <class T>
+        constexpr std::size_t tile_size(std::size_t cache_size) noexcept
+        {
+            std::size_t n = 8;
+            while (2 * (2 * n) * (2 * n) * sizeof(T) <= cache_size)
+            {
+                n *= 2;
+            }
+            return n;
+        }
+
+        inline std::ptrdiff_t abs_stride(std::ptrdiff_t s) noexcept
+        {
+            return s < 0 ? -s : s;
+        }
+    }
+
+    template <class E1, class E2>
+    inline bool blocked_assigner::run(E1& e1, const E2& e2)
+    {
+        using is_strided = std::integral_constant<bool, detail::has_memory_span<E1>::value &&
+                                                        detail::has_memory_span<E2>::value>;
+        return run_impl(e1, e2, is_strided());
+    }
+
+    template <class E1, class E2>
+    inline bool blocked_assigner::run_impl(E1& e1, const E2& e2, std::true_type)
+    {
+        using size_type = std::size_t;
+        const auto& shape = e1.shape();
+        size_type dim = shape.size();
+        if (e2.dimension() != dim || !std::equal(shape.cbegin(), shape.cend(), e2.shape().begin()))
+        {
+            return false;
+        }
+
+        const auto& lhs_strides = e1.strides();
+        const auto& rhs_strides = e2.strides();
+        auto lhs_stride = [&lhs_strides](size_type d) { return static_cast<std::ptrdiff_t>(lhs_strides[d]); };
+        auto rhs_stride = [&rhs_strides](size_type d) { return static_cast<std::ptrdiff_t>(rhs_strides[d]); };
+
+        // Dimensions along which the lhs and the rhs are the most contiguous
+        size_type lhs_inner = dim;
+        size_type rhs_inner = dim;
+        for (size_type d = 0; d < dim; ++d)
+        {
+            if (shape[d] > 1)
+            {
+                if (lhs_inner == dim || detail::abs_stride(lhs_stride(d)) < detail::abs_stride(lhs_stride(lhs_inner)))
+                {
+                    lhs_inner = d;
+                }
+                if (rhs_inner == dim || detail::abs_stride(rhs_stride(d)) < detail::abs_stride(rhs_stride(rhs_inner)))
+                {
+                    rhs_inner = d;
+                }
+            }
+        }
+        if (lhs_inner == dim || lhs_inner == rhs_inner ||
+            detail::abs_stride(rhs_stride(lhs_inner)) == detail::abs_stride(rhs_stride(rhs_inner)))
+        {
+            return false;
+        }
+
+        dynamic_shape<size_type> outer_dims;
+        size_type outer_size = 1;
+        for (size_type d = 0; d < dim; ++d)
+        {
+            if (d != lhs_inner && d != rhs_inner)
+            {
+                outer_dims.push_back(d);
+                outer_size *= shape[d];
+            }
+        }
+
+        auto* lhs = e1.raw_data() + e1.raw_data_offset();
+        const auto* rhs = e2.raw_data() + e2.raw_data_offset();
+        dynamic_shape<size_type> index(outer_dims.size(), size_type(0));
+        for (size_type n = 0; n < outer_size; ++n)
+        {
+            std::ptrdiff_t lhs_offset = 0;
+            std::ptrdiff_t rhs_offset = 0;
+            for (size_type k = 0; k < outer_dims.size(); ++k)
+            {
+                lhs_offset += static_cast<std::ptrdiff_t>(index[k]) * lhs_stride(outer_dims[k]);
+                rhs_offset += static_cast<std::ptrdiff_t>(index[k]) * rhs_stride(outer_dims[k]);
+            }
+            assign_tiles(lhs + lhs_offset, rhs + rhs_offset, shape[lhs_inner], shape[rhs_inner],
+                         lhs_stride(lhs_inner), lhs_stride(rhs_inner), rhs_stride(lhs_inner), rhs_stride(rhs_inner));
+
+            for (size_type k = outer_dims.size(); k != 0; --k)
+            {
+                if (++index[k - 1] != shape[outer_dims[k - 1]])
+                {
+                    break;
+                }
+                index[k - 1] = 0;
+            }
+        }
+        return true;
+    }
+
+    template <class E1, class E2>
+    inline bool blocked_assigner::run_impl(E1&, const E2&, std::false_type)
+    {
+        return false;
+    }
+
+    /**
+     * Assigns a 2-D block by square tiles: the L1 tiles of an L2 tile are
+     * visited before moving on to the next L2 tile. Within an L1 tile, the
+     * lhs is written contiguously. Rows of L2 tiles are split between threads.
+     */
+    template <class T1, class T2>
+    inline void blocked_assigner::assign_tiles(T1* lhs, const T2* rhs, std::size_t n_inner, std::size_t n_outer,
+                                               std::ptrdiff_t lhs_inner, std::ptrdiff_t lhs_outer,
+                                               std::ptrdiff_t rhs_inner, std::ptrdiff_t rhs_outer)
+    {
+        using size_type = std::size_t;
+        using value_type = std::conditional_t<(sizeof(T1) > sizeof(T2)), T1, T2>;
+        constexpr size_type l1_tile = detail::tile_size<value_type>(XTENSOR_L1_CACHE_SIZE);
+        constexpr size_type l2_tile = std::max(detail::tile_size<value_type>(XTENSOR_L2_CACHE_SIZE), l1_tile);
+
+        size_type n_rows = (n_outer + l2_tile - 1) / l2_tile;
+        size_type grain = std::max(size_type(XTENSOR_PARALLEL_GRAIN_SIZE) / (l2_tile * n_inner), size_type(1));
+        detail::parallel_for(0, n_rows, grain, [=](size_type first, size_type last) {
+            size_type outer_end = std::min(last * l2_tile, n_outer);
+            for (size_type jb2 = first * l2_tile; jb2 < outer_end; jb2 += l2_tile)
+            {
+                for (size_type ib2 = 0; ib2 < n_inner; ib2 += l2_tile)
+                {
+                    size_type j_end2 = std::min(jb2 + l2_tile, n_outer);
+                    size_type i_end2 = std::min(ib2 + l2_tile, n_inner);
+                    for (size_type jb = jb2; jb < j_end2; jb += l1_tile)
+                    {
+                        for (size_type ib = ib2; ib < i_end2; ib += l1_tile)
+                        {
+                            size_type j_end = std::min(jb + l1_tile, j_end2);
+                            size_type i_end = std::min(ib + l1_tile, i_end2);
+                            for (size_type j = jb; j < j_end; ++j)
+                            {
+                                T1* lhs_row = lhs + static_cast<std::ptrdiff_t>(j) * lhs_outer;
+                                const T2* rhs_row = rhs + static_cast<std::ptrdiff_t>(j) * rhs_outer;
+                                for (size_type i = ib; i < i_end; ++i)
+                                {
+                                    lhs_row[static_cast<std::ptrdiff_t>(i) * lhs_inner] =
+                                        static_cast<T1>(rhs_row[static_cast<std::ptrdiff_t>(i) * rhs_inner]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    /*********************************
+     * memory_overlap implementation *
+     *********************************/
+
+    namespace detail
+    {
+        /**
+         * Address range spanned by the elements of an expression
+         * with a raw data interface.
+         */
+        struct xmemory_span
+        {
+            const char* data;
+            const char* begin;
+            const char* end;
+        };
+
+        template <class E>
+        inline xmemory_span make_memory_span(const E& e)
+        {
+            const auto* data = e.raw_data() + e.raw_data_offset();
+            const auto& shape = e.shape();
+            const auto& strides = e.strides();
+            std::ptrdiff_t low = 0;
+            std::ptrdiff_t high = 0;
+            for (std::size_t i = 0; i < shape.size(); ++i)
+            {
+                if (shape[i] == 0)
+                {
+                    const char* p = reinterpret_cast<const char*>(data);
+                    return {p, p, p};
+                }
+                std::ptrdiff_t extent = static_cast<std::ptrdiff_t>(shape[i] - 1) * static_cast<std::ptrdiff_t>(strides[i]);
+                (extent < 0 ? low : high) += extent;
+            }
+            return {reinterpret_cast<const char*>(data),
+                    reinterpret_cast<const char*>(data + low),
+                    reinterpret_cast<const char*>(data + high + 1)};
+        }
+
+        inline bool intersect(const xmemory_span& lhs, const xmemory_span& rhs) noexcept
+        {
+            std::less<const char*> less;
+            return less(lhs.begin, rhs.end) && less(rhs.begin, lhs.end);
+        }
+
+        template <class E1, class E2>
+        inline bool has_same_layout(const E1& e1, const E2& e2)
+        {
+            const auto& shape1 = e1.shape();
+            const auto& shape2 = e2.shape();
+            if (shape1.size() != shape2.size() || !std::equal(shape1.begin(), shape1.end(), shape2.begin()))
+            {
+                return false;
+            }
+            const auto& strides1 = e1.strides();
+            const auto& strides2 = e2.strides();
+            for (std::size_t i = 0; i < shape1.size(); ++i)
+            {
+                if (shape1[i] != 1 && static_cast<std::ptrdiff_t>(strides1[i]) != static_cast<std::ptrdiff_t>(strides2[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Expressions whose operands are unknown may read from any
+        // memory location.
+        template <class E, class = void>
+        struct overlap_checker
+        {
+            template <class E1>
+            static overlap_type run(const E1&, const xmemory_span&, const E&)
+            {
+                return overlap_type::unsafe;
+            }
+        };
+
+        template <class E2>
+        struct overlap_checker<E2, std::enable_if_t<has_memory_span<E2>::value>>
+        {
+            template <class E1>
+            static overlap_type run(const E1& e1, const xmemory_span& span, const E2& e2)
+            {
+                xmemory_span rhs_span = make_memory_span(e2);
+                if (!intersect(span, rhs_span))
+                {
+                    return overlap_type::none;
+                }
+                bool elementwise = sizeof(typename E1::value_type) == sizeof(typename E2::value_type) &&
+                    span.data == rhs_span.data && has_same_layout(e1, e2);
+                return elementwise ? overlap_type::elementwise : overlap_type::unsafe;
+            }
+        };
+
+        template <class CT>
+        struct overlap_checker<xscalar<CT>>
+        {
+            template <class E1>
+            static overlap_type run(const E1&, const xmemory_span& span, const xscalar<CT>& e2)
+            {
+                const char* p = reinterpret_cast<const char*>(std::addressof(e2()));
+                std::less<const char*> less;
+                return (!less(p, span.begin) && less(p, span.end)) ? overlap_type::unsafe : overlap_type::none;
+            }
+        };
+
+        template <class F, class R, class... CT>
+        struct overlap_checker<xfunction<F, R, CT...>>
+        {
+            template <class E1>
+            static overlap_type run(const E1& e1, const xmemory_span& span, const xfunction<F, R, CT...>& e2)
+            {
+                auto func = [&e1, &span](overlap_type init, const auto& arg) {
+                    using arg_type = std::decay_t<decltype(arg)>;
+                    overlap_type res = overlap_checker<arg_type>::run(e1, span, arg);
+                    return res > init ? res : init;
+                };
+                return accumulate(func, overlap_type::none, e2.arguments());
+            }
+        };
+
+        template <class E1, class E2>
+        inline overlap_type memory_overlap_impl(const E1& e1, const E2& e2, std::true_type)
+        {
+            return overlap_checker<E2>::run(e1, make_memory_span(e1), e2);
+        }
+
+        template <class E1, class E2>
+        inline overlap_type memory_overlap_impl(const E1&, const E2&, std::false_type)
+        {
+            return overlap_type::unsafe;
+        }
+
+        /**
+         * Compares the memory written by an assignment to \c e1 with the
+         * memory read by every leaf of \c e2. The overlap is elementwise
+         * when the only leaves sharing memory with \c e1 have the same
+         * data, shape and strides: each element is then read before being
+         * written, and the assignment does not need a temporary as long
+         * as it does not resize \c e1. Leaves whose memory cannot be known
+         * are considered unsafe.
+         */
+        template <class E1, class E2>
+        inline overlap_type memory_overlap(const E1& e1, const E2& e2)
+        {
+            return memory_overlap_impl(e1, e2, has_memory_span<E1>());
+        }
+
+        template <class E1, class E2>
+        inline bool has_same_broadcast_shape(const E1& e1, const E2& e2)
+        {
+            using size_type = typename E1::size_type;
+            size_type dim = e2.dimension();
+            dynamic_shape<size_type> shape(dim, size_type(1));
+            e2.broadcast_shape(shape, true);
+            return dim == e1.dimension() && std::equal(shape.cbegin(), shape.cend(), e1.shape().begin());
+        }
+    }
 }
 
 #endif
@@ -0,0 +1,229 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XTENSOR_ASSIGN_STATS_HPP
+#define XTENSOR_ASSIGN_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef XTENSOR_ENABLE_ASSIGN_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+#include "xtensor_config.hpp"
+
+namespace xt
+{
+
+    /*****************
+     * xassign_stats *
+     *****************/
+
+    /**
+     * Evaluation paths of an assignment.
+     */
+    enum class assign_path
+    {
+        simd_trivial,
+        scalar_trivial,
+        blocked,
+        stepper
+    };
+
+    /**
+     * Statistics of the assignments that took a given path.
+     */
+    struct xassign_path_stats
+    {
+        std::size_t count = 0;
+        std::size_t elements = 0;
+        std::size_t bytes = 0;
+        double seconds = 0.;
+    };
+
+    /**
+     * @class xassign_stats
+     * @brief Snapshot of the assignment statistics.
+     *
+     * The statistics are only collected when XTENSOR_ENABLE_ASSIGN_STATS
+     * is defined, they are always zero otherwise. Bytes are the bytes
+     * written to the assigned expression.
+     */
+    struct xassign_stats
+    {
+        static constexpr std::size_t path_count = 4;
+
+        const xassign_path_stats& operator[](assign_path p) const noexcept;
+
+        std::array<xassign_path_stats, path_count> paths;
+        std::size_t temporaries = 0;
+        std::size_t temporary_bytes = 0;
+    };
+
+    xassign_stats get_assign_stats() noexcept;
+    void reset_assign_stats() noexcept;
+
+    namespace detail
+    {
+        void record_temporary(std::size_t bytes) noexcept;
+    }
+
+    /********************************
+     * xassign_stats implementation *
+     ********************************/
+
+    inline const xassign_path_stats& xassign_stats::operator[](assign_path p) const noexcept
+    {
+        return paths[static_cast<std::size_t>(p)];
+    }
+
+#ifdef XTENSOR_ENABLE_ASSIGN_STATS
+
+    namespace detail
+    {
+        struct xassign_path_counters
+        {
+            std::atomic<std::size_t> count{0};
+            std::atomic<std::size_t> elements{0};
+            std::atomic<std::size_t> bytes{0};
+            std::atomic<std::uint64_t> nanoseconds{0};
+        };
+
+        struct xassign_counters
+        {
+            std::array<xassign_path_counters, xassign_stats::path_count> paths;
+            std::atomic<std::size_t> temporaries{0};
+            std::atomic<std::size_t> temporary_bytes{0};
+        };
+
+        inline xassign_counters& assign_counters() noexcept
+        {
+            static xassign_counters counters;
+            return counters;
+        }
+
+        /**
+         * Measures the wall time of an assignment and records it
+         * with the path it took.
+         */
+        class xassign_recorder
+        {
+        public:
+
+            xassign_recorder(std::size_t elements, std::size_t bytes) noexcept;
+
+            void record(assign_path p) const noexcept;
+
+        private:
+
+            using clock_type = std::chrono::steady_clock;
+
+            clock_type::time_point m_start;
+            std::size_t m_elements;
+            std::size_t m_bytes;
+        };
+
+        inline xassign_recorder::xassign_recorder(std::size_t elements, std::size_t bytes) noexcept
+            : m_start(clock_type::now()), m_elements(elements), m_bytes(bytes)
+        {
+        }
+
+        inline void xassign_recorder::record(assign_path p) const noexcept
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_start);
+            xassign_path_counters& c = assign_counters().paths[static_cast<std::size_t>(p)];
+            c.count.fetch_add(1, std::memory_order_relaxed);
+            c.elements.fetch_add(m_elements, std::memory_order_relaxed);
+            c.bytes.fetch_add(m_bytes, std::memory_order_relaxed);
+            c.nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        }
+
+        inline void record_temporary(std::size_t bytes) noexcept
+        {
+            xassign_counters& c = assign_counters();
+            c.temporaries.fetch_add(1, std::memory_order_relaxed);
+            c.temporary_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Returns the statistics of the assignments evaluated since the
+     * start of the program or the last call to reset_assign_stats.
+     */
+    inline xassign_stats get_assign_stats() noexcept
+    {
+        const detail::xassign_counters& c = detail::assign_counters();
+        xassign_stats res;
+        for (std::size_t i = 0; i < xassign_stats::path_count; ++i)
+        {
+            const detail::xassign_path_counters& pc = c.paths[i];
+            res.paths[i].count = pc.count.load(std::memory_order_relaxed);
+            res.paths[i].elements = pc.elements.load(std::memory_order_relaxed);
+            res.paths[i].bytes = pc.bytes.load(std::memory_order_relaxed);
+            res.paths[i].seconds = 1e-9 * static_cast<double>(pc.nanoseconds.load(std::memory_order_relaxed));
+        }
+        res.temporaries = c.temporaries.load(std::memory_order_relaxed);
+        res.temporary_bytes = c.temporary_bytes.load(std::memory_order_relaxed);
+        return res;
+    }
+
+    /**
+     * Resets the assignment statistics.
+     */
+    inline void reset_assign_stats() noexcept
+    {
+        detail::xassign_counters& c = detail::assign_counters();
+        for (auto& pc : c.paths)
+        {
+            pc.count.store(0, std::memory_order_relaxed);
+            pc.elements.store(0, std::memory_order_relaxed);
+            pc.bytes.store(0, std::memory_order_relaxed);
+            pc.nanoseconds.store(0, std::memory_order_relaxed);
+        }
+        c.temporaries.store(0, std::memory_order_relaxed);
+        c.temporary_bytes.store(0, std::memory_order_relaxed);
+    }
+
+#else
+
+    namespace detail
+    {
+        class xassign_recorder
+        {
+        public:
+
+            xassign_recorder(std::size_t, std::size_t) noexcept
+            {
+            }
+
+            void record(assign_path) const noexcept
+            {
+            }
+        };
+
+        inline void record_temporary(std::size_t) noexcept
+        {
+        }
+    }
+
+    inline xassign_stats get_assign_stats() noexcept
+    {
+        return xassign_stats();
+    }
+
+    inline void reset_assign_stats() noexcept
+    {
+    }
+
+#endif
+}
+
+#endif
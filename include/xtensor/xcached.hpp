@@ -0,0 +1,378 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XTENSOR_CACHED_HPP
+#define XTENSOR_CACHED_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "xarray.hpp"
+#include "xexpression.hpp"
+#include "xiterable.hpp"
+#include "xtensor.hpp"
+#include "xutils.hpp"
+
+namespace xt
+{
+
+    template <class CT>
+    class xcached;
+
+    namespace detail
+    {
+        template <class T, class S>
+        struct xcached_temporary_type
+        {
+            using type = xarray<T>;
+        };
+
+        template <class T, class I, std::size_t N>
+        struct xcached_temporary_type<T, std::array<I, N>>
+        {
+            using type = xtensor<T, N>;
+        };
+    }
+
+    template <class CT>
+    struct xcontainer_inner_types<xcached<CT>>
+    {
+        using xexpression_type = std::decay_t<CT>;
+        using temporary_type = typename detail::xcached_temporary_type<typename xexpression_type::value_type,
+                                                                      typename xexpression_type::shape_type>::type;
+    };
+
+    template <class CT>
+    struct xiterable_inner_types<xcached<CT>>
+    {
+        using xexpression_type = std::decay_t<CT>;
+        using temporary_type = typename xcontainer_inner_types<xcached<CT>>::temporary_type;
+        using inner_shape_type = typename xexpression_type::shape_type;
+        using const_stepper = typename temporary_type::const_stepper;
+        using stepper = const_stepper;
+    };
+
+    /***********
+     * xcached *
+     ***********/
+
+    /**
+     * @class xcached
+     * @brief Expression evaluated on first access.
+     *
+     * The xcached class implements an \ref xexpression that evaluates the
+     * expression it wraps into a container it owns the first time one of
+     * its elements is accessed, and serves the subsequent accesses from
+     * that container. It avoids recomputing expressions whose elements
+     * are expensive, such as lazy reducers broadcast against the reduced
+     * expression.
+     *
+     * The evaluation happens once, even if the first accesses are
+     * concurrent. Copies of an xcached share its container. The container
+     * is not updated when the wrapped expression changes after the
+     * evaluation.
+     *
+     * @tparam CT the closure type of the \ref xexpression to cache
+     *
+     * @sa cached
+     */
+    template <class CT>
+    class xcached : public xexpression<xcached<CT>>,
+                    public xconst_iterable<xcached<CT>>
+    {
+    public:
+
+        using self_type = xcached<CT>;
+        using xexpression_type = std::decay_t<CT>;
+        using temporary_type = typename xcontainer_inner_types<self_type>::temporary_type;
+
+        using value_type = typename temporary_type::value_type;
+        using reference = typename temporary_type::const_reference;
+        using const_reference = typename temporary_type::const_reference;
+        using pointer = typename temporary_type::const_pointer;
+        using const_pointer = typename temporary_type::const_pointer;
+        using size_type = typename temporary_type::size_type;
+        using difference_type = typename temporary_type::difference_type;
+
+        using iterable_base = xconst_iterable<self_type>;
+        using inner_shape_type = typename iterable_base::inner_shape_type;
+        using shape_type = inner_shape_type;
+
+        using stepper = typename iterable_base::stepper;
+        using const_stepper = typename iterable_base::const_stepper;
+
+        static constexpr layout_type static_layout = temporary_type::static_layout;
+        static constexpr bool contiguous_layout = false;
+
+        template <class CTA>
+        explicit xcached(CTA&& e);
+
+        size_type size() const noexcept;
+        size_type dimension() const noexcept;
+        const inner_shape_type& shape() const noexcept;
+        layout_type layout() const noexcept;
+
+        template <class... Args>
+        const_reference operator()(Args... args) const;
+        template <class... Args>
+        const_reference at(Args... args) const;
+        template <class S>
+        disable_integral_t<S, const_reference> operator[](const S& index) const;
+        template <class I>
+        const_reference operator[](std::initializer_list<I> index) const;
+        const_reference operator[](size_type i) const;
+
+        template <class It>
+        const_reference element(It first, It last) const;
+
+        const temporary_type& value() const;
+
+        template <class S>
+        bool broadcast_shape(S& shape, bool reuse_cache = false) const;
+
+        template <class S>
+        bool is_trivial_broadcast(const S& strides) const noexcept;
+
+        template <class S>
+        const_stepper stepper_begin(const S& shape) const;
+        template <class S>
+        const_stepper stepper_end(const S& shape, layout_type l) const;
+
+    private:
+
+        struct cache_state
+        {
+            std::once_flag m_flag;
+            temporary_type m_value;
+        };
+
+        CT m_e;
+        std::shared_ptr<cache_state> m_cache;
+    };
+
+    /**
+     * Returns an \ref xexpression evaluating \p e on first access.
+     *
+     * \code{.cpp}
+     * xt::xarray<double> a = {{1., 2.}, {3., 4.}};
+     * // the mean is computed once, not once per element of a
+     * xt::xarray<double> b = a - xt::cached(xt::mean(a, {0}));
+     * \endcode
+     *
+     * @param e the \ref xexpression to cache
+     * @sa xcached
+     */
+    template <class E>
+    inline auto cached(E&& e)
+    {
+        using type = xcached<const_xclosure_t<E>>;
+        return type(std::forward<E>(e));
+    }
+
+    /**************************
+     * xcached implementation *
+     **************************/
+
+    /**
+     * @name Constructor
+     */
+    //@{
+    /**
+     * Constructs an xcached expression wrapping the given expression.
+     * The expression is not evaluated until one of the elements is accessed.
+     *
+     * @param e the expression to cache
+     */
+    template <class CT>
+    template <class CTA>
+    inline xcached<CT>::xcached(CTA&& e)
+        : m_e(std::forward<CTA>(e)), m_cache(std::make_shared<cache_state>())
+    {
+    }
+    //@}
+
+    /**
+     * @name Size and shape
+     */
+    //@{
+    /**
+     * Returns the size of the expression.
+     */
+    template <class CT>
+    inline auto xcached<CT>::size() const noexcept -> size_type
+    {
+        return compute_size(shape());
+    }
+
+    /**
+     * Returns the number of dimensions of the expression.
+     */
+    template <class CT>
+    inline auto xcached<CT>::dimension() const noexcept -> size_type
+    {
+        return shape().size();
+    }
+
+    /**
+     * Returns the shape of the expression.
+     */
+    template <class CT>
+    inline auto xcached<CT>::shape() const noexcept -> const inner_shape_type&
+    {
+        return m_e.shape();
+    }
+
+    /**
+     * Returns the layout of the evaluated expression.
+     */
+    template <class CT>
+    inline layout_type xcached<CT>::layout() const noexcept
+    {
+        return static_layout == layout_type::dynamic ? DEFAULT_LAYOUT : static_layout;
+    }
+    //@}
+
+    /**
+     * @name Data
+     */
+    //@{
+    /**
+     * Returns a constant reference to the element at the specified position in the expression.
+     * @param args a list of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices should be equal or greater than
+     * the number of dimensions of the expression.
+     */
+    template <class CT>
+    template <class... Args>
+    inline auto xcached<CT>::operator()(Args... args) const -> const_reference
+    {
+        return value()(args...);
+    }
+
+    /**
+     * Returns a constant reference to the element at the specified position in the expression,
+     * after dimension and bounds checking.
+     * @param args a list of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices should be equal to the number of dimensions
+     * of the expression.
+     * @exception std::out_of_range if the number of argument is greater than the number of dimensions
+     * or if indices are out of bounds.
+     */
+    template <class CT>
+    template <class... Args>
+    inline auto xcached<CT>::at(Args... args) const -> const_reference
+    {
+        check_access(shape(), static_cast<size_type>(args)...);
+        return this->operator()(args...);
+    }
+
+    /**
+     * Returns a constant reference to the element at the specified position in the expression.
+     * @param index a sequence of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices in the sequence should be equal or greater
+     * than the number of dimensions of the expression.
+     */
+    template <class CT>
+    template <class S>
+    inline auto xcached<CT>::operator[](const S& index) const
+        -> disable_integral_t<S, const_reference>
+    {
+        return element(index.cbegin(), index.cend());
+    }
+
+    template <class CT>
+    template <class I>
+    inline auto xcached<CT>::operator[](std::initializer_list<I> index) const
+        -> const_reference
+    {
+        return element(index.begin(), index.end());
+    }
+
+    template <class CT>
+    inline auto xcached<CT>::operator[](size_type i) const -> const_reference
+    {
+        return operator()(i);
+    }
+
+    /**
+     * Returns a constant reference to the element at the specified position in the expression.
+     * @param first iterator starting the sequence of indices
+     * @param last iterator ending the sequence of indices
+     * The number of indices in the sequence should be equal to or greater
+     * than the number of dimensions of the expression.
+     */
+    template <class CT>
+    template <class It>
+    inline auto xcached<CT>::element(It first, It last) const -> const_reference
+    {
+        return value().element(first, last);
+    }
+
+    /**
+     * Returns the container holding the evaluated expression. The
+     * expression is evaluated on the first call.
+     */
+    template <class CT>
+    inline auto xcached<CT>::value() const -> const temporary_type&
+    {
+        cache_state& cache = *m_cache;
+        std::call_once(cache.m_flag, [this, &cache]() { cache.m_value = m_e; });
+        return cache.m_value;
+    }
+    //@}
+
+    /**
+     * @name Broadcasting
+     */
+    //@{
+    /**
+     * Broadcast the shape of the expression to the specified parameter.
+     * @param shape the result shape
+     * @param reuse_cache parameter for internal optimization
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class CT>
+    template <class S>
+    inline bool xcached<CT>::broadcast_shape(S& shape, bool) const
+    {
+        return xt::broadcast_shape(this->shape(), shape);
+    }
+
+    /**
+     * Compares the specified strides with those of the evaluated expression
+     * to see whether the broadcasting is trivial.
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class CT>
+    template <class S>
+    inline bool xcached<CT>::is_trivial_broadcast(const S& /*strides*/) const noexcept
+    {
+        return false;
+    }
+    //@}
+
+    template <class CT>
+    template <class S>
+    inline auto xcached<CT>::stepper_begin(const S& shape) const -> const_stepper
+    {
+        return value().stepper_begin(shape);
+    }
+
+    template <class CT>
+    template <class S>
+    inline auto xcached<CT>::stepper_end(const S& shape, layout_type l) const -> const_stepper
+    {
+        return value().stepper_end(shape, l);
+    }
+}
+
+#endif
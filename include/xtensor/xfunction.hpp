@@ -260,7 +260,8 @@ namespace xt
         template <class align, class simd = simd_value_type>
         detail::simd_return_type_t<functor_type, simd> load_simd(size_type i) const;
 
-        const std::tuple<CT...>& arguments() const noexcept;
+        const std::tuple<CT...>& arguments() const & noexcept;
+        std::tuple<CT...>&& arguments() && noexcept;
 
     protected:
 
@@ -443,6 +444,15 @@ namespace xt
 
         reference operator*() const;
 
+        template <class T>
+        std::enable_if_t<detail::conjunction_c<detail::has_simd_step<typename std::decay_t<CT>::const_stepper, T>::value...>::value,
+                         detail::simd_return_type_t<functor_type, T>>
+        step_simd(size_type dim);
+        bool has_linear_step(size_type dim) const noexcept;
+        template <class B = bool>
+        std::enable_if_t<detail::conjunction_c<detail::has_equivalent_step<typename std::decay_t<CT>::const_stepper>::value...>::value, B>
+        is_equivalent_step(size_type dim1, size_type n1, size_type dim2, size_type n2) const noexcept;
+
         bool equal(const self_type& rhs) const;
 
     private:
@@ -450,6 +460,9 @@ namespace xt
         template <std::size_t... I>
         reference deref_impl(std::index_sequence<I...>) const;
 
+        template <class T, std::size_t... I>
+        T step_simd_impl(std::index_sequence<I...>, size_type dim);
+
         const xfunction_type* p_f;
         std::tuple<typename std::decay_t<CT>::const_stepper...> m_it;
     };
@@ -777,11 +790,17 @@ namespace xt
     }
 
     template <class F, class R, class... CT>
-    inline auto xfunction_base<F, R, CT...>::arguments() const noexcept -> const std::tuple<CT...>&
+    inline auto xfunction_base<F, R, CT...>::arguments() const & noexcept -> const std::tuple<CT...>&
     {
         return m_e;
     }
 
+    template <class F, class R, class... CT>
+    inline auto xfunction_base<F, R, CT...>::arguments() && noexcept -> std::tuple<CT...>&&
+    {
+        return std::move(m_e);
+    }
+
     template <class F, class R, class... CT>
     template <std::size_t... I>
     inline layout_type xfunction_base<F, R, CT...>::layout_impl(std::index_sequence<I...>) const noexcept
@@ -996,6 +1015,32 @@ namespace xt
         return deref_impl(std::make_index_sequence<sizeof...(CT)>());
     }
 
+    template <class F, class R, class... CT>
+    template <class T>
+    inline auto xfunction_stepper<F, R, CT...>::step_simd(size_type dim)
+        -> std::enable_if_t<detail::conjunction_c<detail::has_simd_step<typename std::decay_t<CT>::const_stepper, T>::value...>::value,
+                            detail::simd_return_type_t<functor_type, T>>
+    {
+        return step_simd_impl<T>(std::make_index_sequence<sizeof...(CT)>(), dim);
+    }
+
+    template <class F, class R, class... CT>
+    inline bool xfunction_stepper<F, R, CT...>::has_linear_step(size_type dim) const noexcept
+    {
+        auto func = [dim](bool b, const auto& it) { return b && it.has_linear_step(dim); };
+        return accumulate(func, true, m_it);
+    }
+
+    template <class F, class R, class... CT>
+    template <class B>
+    inline auto xfunction_stepper<F, R, CT...>::is_equivalent_step(size_type dim1, size_type n1,
+                                                                   size_type dim2, size_type n2) const noexcept
+        -> std::enable_if_t<detail::conjunction_c<detail::has_equivalent_step<typename std::decay_t<CT>::const_stepper>::value...>::value, B>
+    {
+        auto func = [=](bool b, const auto& it) { return b && it.is_equivalent_step(dim1, n1, dim2, n2); };
+        return accumulate(func, true, m_it);
+    }
+
     template <class F, class R, class... CT>
     inline bool xfunction_stepper<F, R, CT...>::equal(const self_type& rhs) const
     {
@@ -1009,6 +1054,13 @@ namespace xt
         return (p_f->m_f)(*std::get<I>(m_it)...);
     }
 
+    template <class F, class R, class... CT>
+    template <class T, std::size_t... I>
+    inline auto xfunction_stepper<F, R, CT...>::step_simd_impl(std::index_sequence<I...>, size_type dim) -> T
+    {
+        return (p_f->m_f).simd_apply(std::get<I>(m_it).template step_simd<T>(dim)...);
+    }
+
     template <class F, class R, class... CT>
     inline bool operator==(const xfunction_stepper<F, R, CT...>& it1,
                            const xfunction_stepper<F, R, CT...>& it2)
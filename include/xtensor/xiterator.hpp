@@ -22,6 +22,7 @@
 #include "xexception.hpp"
 #include "xlayout.hpp"
 #include "xshape.hpp"
+#include "xtensor_simd.hpp"
 #include "xutils.hpp"
 
 namespace xt
@@ -82,6 +83,32 @@ namespace xt
     template <class C>
     using xindex_type_t = typename detail::index_type_impl<C>::type;
 
+    namespace detail
+    {
+        template <class S, class T, class = void_t<>>
+        struct has_simd_step : std::false_type
+        {
+        };
+
+        template <class S, class T>
+        struct has_simd_step<S, T, void_t<decltype(std::declval<S&>().template step_simd<T>(typename S::size_type(0)))>>
+            : std::true_type
+        {
+        };
+
+        template <class S, class = void_t<>>
+        struct has_equivalent_step : std::false_type
+        {
+        };
+
+        template <class S>
+        struct has_equivalent_step<S, void_t<decltype(std::declval<const S&>().is_equivalent_step(typename S::size_type(0), typename S::size_type(0),
+                                                                                                    typename S::size_type(0), typename S::size_type(0)))>>
+            : std::true_type
+        {
+        };
+    }
+
     /************
      * xstepper *
      ************/
@@ -114,6 +141,11 @@ namespace xt
         void to_begin();
         void to_end(layout_type l);
 
+        template <class T>
+        std::enable_if_t<std::is_pointer<subiterator_type>::value, T> step_simd(size_type dim);
+        bool has_linear_step(size_type dim) const noexcept;
+        bool is_equivalent_step(size_type dim1, size_type n1, size_type dim2, size_type n2) const noexcept;
+
         bool equal(const xstepper& rhs) const;
 
     private:
@@ -453,6 +485,55 @@ namespace xt
         m_it = p_c->data_xend(l);
     }
 
+    /**
+     * Loads a batch of T::size consecutive values along the dimension dim
+     * and moves the stepper past them. This requires has_linear_step(dim)
+     * to hold; if the dimension is broadcast, the current value is
+     * broadcast to the whole batch and the stepper does not move.
+     */
+    template <class C>
+    template <class T>
+    inline auto xstepper<C>::step_simd(size_type dim) -> std::enable_if_t<std::is_pointer<subiterator_type>::value, T>
+    {
+        if (dim >= m_offset && p_c->strides()[dim - m_offset] != 0)
+        {
+            T res = xsimd::load_simd<value_type, typename T::value_type>(m_it, xsimd::unaligned_mode());
+            m_it += difference_type(T::size);
+            return res;
+        }
+        return xsimd::set_simd<value_type, typename T::value_type>(*m_it);
+    }
+
+    /**
+     * Returns true if stepping along the dimension dim moves the stepper
+     * to the next element in memory, or does not move it at all.
+     */
+    template <class C>
+    inline bool xstepper<C>::has_linear_step(size_type dim) const noexcept
+    {
+        if (dim < m_offset)
+        {
+            return true;
+        }
+        auto stride = p_c->strides()[dim - m_offset];
+        return stride == 0 || stride == 1;
+    }
+
+    /**
+     * Returns true if stepping n1 times along the dimension dim1 and
+     * stepping n2 times along the dimension dim2 move the stepper to the
+     * same position.
+     */
+    template <class C>
+    inline bool xstepper<C>::is_equivalent_step(size_type dim1, size_type n1, size_type dim2, size_type n2) const noexcept
+    {
+        auto offset = [this](size_type dim, size_type n) {
+            return (n == 0 || dim < m_offset) ? difference_type(0)
+                                              : static_cast<difference_type>(n) * static_cast<difference_type>(p_c->strides()[dim - m_offset]);
+        };
+        return offset(dim1, n1) == offset(dim2, n2);
+    }
+
     template <class C>
     inline bool xstepper<C>::equal(const xstepper& rhs) const
     {
@@ -13,9 +13,14 @@
 #ifndef XTENSOR_MATH_HPP
 #define XTENSOR_MATH_HPP
 
+#include <array>
 #include <cmath>
 #include <complex>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <type_traits>
+#include <vector>
 
 #include "xoperation.hpp"
 #include "xreducer.hpp"
@@ -376,7 +381,8 @@ INT_SPECIALIZATION_IMPL(FUNC_NAME, RETURN_VAL, unsigned long long);
 
 #define REDUCER_FUNCTION(NAME, FUNCTOR, RESULT_TYPE)                                                              \
     template <class E, class X, class ES = DEFAULT_STRATEGY_REDUCERS,                                             \
-              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value, int>> \
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value &&    \
+                                       std::is_base_of<evaluation_strategy::base, ES>::value, int>>              \
     inline auto NAME(E&& e, X&& axes, ES es = ES()) noexcept                                                      \
     {                                                                                                             \
         using result_type = RESULT_TYPE;                                                                          \
@@ -392,25 +398,56 @@ INT_SPECIALIZATION_IMPL(FUNC_NAME, RETURN_VAL, unsigned long long);
         using result_type = RESULT_TYPE;                                                                          \
         using functor_type = FUNCTOR<result_type>;                                                                \
         return reduce(make_xreducer_functor(functor_type()), std::forward<E>(e), es);                             \
+    }                                                                                                             \
+                                                                                                                  \
+    template <class E, class X, class R, class ES = DEFAULT_STRATEGY_REDUCERS,                                    \
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value &&    \
+                                       !std::is_base_of<evaluation_strategy::base, R>::value, int>>              \
+    inline R& NAME(E&& e, X&& axes, R& out, ES es = ES())                                                         \
+    {                                                                                                             \
+        using result_type = RESULT_TYPE;                                                                          \
+        using functor_type = FUNCTOR<result_type>;                                                                \
+        return reduce(make_xreducer_functor(functor_type()), std::forward<E>(e),                                  \
+                      std::forward<X>(axes), out, es);                                                            \
     }                                                                                                             \
 
 #define OLD_CLANG_REDUCER(NAME, FUNCTOR, RESULT_TYPE)                                                             \
-    template <class E, class I, class ES = DEFAULT_STRATEGY_REDUCERS>                                             \
+    template <class E, class I, class ES = DEFAULT_STRATEGY_REDUCERS,                                             \
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>               \
         inline auto NAME(E&& e, std::initializer_list<I> axes, ES es = ES()) noexcept                             \
         {                                                                                                         \
             using result_type = RESULT_TYPE;                                                                      \
             using functor_type = FUNCTOR<result_type>;                                                            \
             return reduce(make_xreducer_functor(functor_type()), std::forward<E>(e), axes);                       \
+        }                                                                                                         \
+                                                                                                                  \
+    template <class E, class I, class R,                                                                          \
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, R>::value, int>>               \
+        inline R& NAME(E&& e, std::initializer_list<I> axes, R& out)                                              \
+        {                                                                                                         \
+            using result_type = RESULT_TYPE;                                                                      \
+            using functor_type = FUNCTOR<result_type>;                                                            \
+            return reduce(make_xreducer_functor(functor_type()), std::forward<E>(e), axes, out);                  \
         }                                                                                                         \
 
 #define MODERN_CLANG_REDUCER(NAME, FUNCTOR, RESULT_TYPE)                                                          \
-    template <class E, class I, std::size_t N, class ES = DEFAULT_STRATEGY_REDUCERS>                              \
+    template <class E, class I, std::size_t N, class ES = DEFAULT_STRATEGY_REDUCERS,                              \
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>               \
     inline auto NAME(E&& e, const I (&axes)[N], ES es = ES()) noexcept                                            \
     {                                                                                                             \
         using result_type = RESULT_TYPE;                                                                          \
         using functor_type = FUNCTOR<result_type>;                                                                \
         return reduce(make_xreducer_functor(functor_type()), std::forward<E>(e), axes, es);                       \
     }                                                                                                             \
+                                                                                                                  \
+    template <class E, class I, std::size_t N, class R, class ES = DEFAULT_STRATEGY_REDUCERS,                     \
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, R>::value, int>>               \
+    inline R& NAME(E&& e, const I (&axes)[N], R& out, ES es = ES())                                               \
+    {                                                                                                             \
+        using result_type = RESULT_TYPE;                                                                          \
+        using functor_type = FUNCTOR<result_type>;                                                                \
+        return reduce(make_xreducer_functor(functor_type()), std::forward<E>(e), axes, out, es);                  \
+    }                                                                                                             \
 
 
     /*******************
@@ -621,6 +658,33 @@ INT_SPECIALIZATION_IMPL(FUNC_NAME, RETURN_VAL, unsigned long long);
         };
     }
 
+    namespace detail
+    {
+        template <class T>
+        struct simd_reduce_op<math::minimum<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const math::minimum<T>& f, const B& lhs, const B& rhs)
+            {
+                return f.simd_apply(lhs, rhs);
+            }
+        };
+
+        template <class T>
+        struct simd_reduce_op<math::maximum<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const math::maximum<T>& f, const B& lhs, const B& rhs)
+            {
+                return f.simd_apply(lhs, rhs);
+            }
+        };
+    }
+
     /**
      * @ingroup basic_functions
      * @brief Elementwise maximum
@@ -1581,41 +1645,829 @@ INT_SPECIALIZATION_IMPL(FUNC_NAME, RETURN_VAL, unsigned long long);
      * \em axes.
      * @param e an \ref xexpression
      * @param axes the axes along which the mean is computed (optional)
+     * @param es evaluation strategy of the reduction (optional)
      * @return an \ref xexpression
      */
-    template <class E, class X>
-    inline auto mean(E&& e, X&& axes) noexcept
+    template <class E, class X, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value &&
+                                       std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto mean(E&& e, X&& axes, ES es = ES()) noexcept
     {
         auto size = e.size();
-        auto s = sum(std::forward<E>(e), std::forward<X>(axes));
+        auto s = sum(std::forward<E>(e), std::forward<X>(axes), es);
         return std::move(s) / static_cast<double>(size / s.size());
     }
 
-    template <class E>
-    inline auto mean(E&& e) noexcept
+    template <class E, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto mean(E&& e, ES es = ES()) noexcept
     {
         auto size = e.size();
-        return sum(std::forward<E>(e)) / static_cast<double>(size);
+        return sum(std::forward<E>(e), es) / static_cast<double>(size);
     }
 
 #ifdef X_OLD_CLANG
-    template <class E, class I>
-    inline auto mean(E&& e, std::initializer_list<I> axes) noexcept
+    template <class E, class I, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto mean(E&& e, std::initializer_list<I> axes, ES es = ES()) noexcept
     {
         auto size = e.size();
-        auto s = sum(std::forward<E>(e), axes);
+        auto s = sum(std::forward<E>(e), axes, es);
         return std::move(s) / static_cast<double>(size / s.size());
     }
 #else
-    template <class E, class I, std::size_t N>
-    inline auto mean(E&& e, const I (&axes)[N]) noexcept
+    template <class E, class I, std::size_t N, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto mean(E&& e, const I (&axes)[N], ES es = ES()) noexcept
     {
         auto size = e.size();
-        auto s = sum(std::forward<E>(e), axes);
+        auto s = sum(std::forward<E>(e), axes, es);
         return std::move(s) / static_cast<double>(size / s.size());
     }
 #endif
 
+    /**************
+     * statistics *
+     **************/
+
+    /**
+     * @class xstats
+     * @brief Descriptive statistics of a set of values.
+     *
+     * Holds the number of values, their mean, the sum of the squared
+     * differences to the mean (M2), their minimum and their maximum.
+     *
+     * @tparam T the value type of the statistics
+     */
+    template <class T>
+    struct xstats
+    {
+        using value_type = T;
+
+        std::size_t count;
+        T mean;
+        T m2;
+        T min;
+        T max;
+
+        T variance(std::size_t ddof = 0) const noexcept;
+        T stddev(std::size_t ddof = 0) const noexcept;
+    };
+
+    /**
+     * Returns the variance of the values, with \c count - \c ddof
+     * degrees of freedom. Returns NaN when there is no degree of freedom
+     * left, i.e. when \c ddof is not smaller than \c count.
+     */
+    template <class T>
+    inline T xstats<T>::variance(std::size_t ddof) const noexcept
+    {
+        if (count <= ddof)
+        {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        return m2 / (static_cast<T>(count) - static_cast<T>(ddof));
+    }
+
+    /**
+     * Returns the standard deviation of the values, with \c count - \c ddof
+     * degrees of freedom.
+     */
+    template <class T>
+    inline T xstats<T>::stddev(std::size_t ddof) const noexcept
+    {
+        using std::sqrt;
+        return sqrt(variance(ddof));
+    }
+
+    namespace detail
+    {
+        template <class V>
+        using stats_value_type_t = std::conditional_t<std::is_floating_point<V>::value, V, double>;
+
+        template <class T>
+        struct stats_init
+        {
+            using result_type = xstats<T>;
+
+            template <class V>
+            result_type operator()(const V& v) const
+            {
+                T t = static_cast<T>(v);
+                return result_type{1, t, T(0), t, t};
+            }
+        };
+
+        // Welford update
+        template <class T>
+        struct stats_reduce
+        {
+            using result_type = xstats<T>;
+
+            template <class V>
+            result_type operator()(const result_type& s, const V& v) const
+            {
+                T t = static_cast<T>(v);
+                result_type res = s;
+                ++res.count;
+                T delta = t - s.mean;
+                res.mean += delta / static_cast<T>(res.count);
+                res.m2 += delta * (t - res.mean);
+                res.min = t < s.min ? t : s.min;
+                res.max = t > s.max ? t : s.max;
+                return res;
+            }
+        };
+
+        // Chan et al. pairwise combination
+        template <class T>
+        struct stats_merge
+        {
+            using result_type = xstats<T>;
+
+            result_type operator()(const result_type& lhs, const result_type& rhs) const
+            {
+                if (lhs.count == 0 || rhs.count == 0)
+                {
+                    return lhs.count == 0 ? rhs : lhs;
+                }
+                result_type res;
+                res.count = lhs.count + rhs.count;
+                T n = static_cast<T>(res.count);
+                T nl = static_cast<T>(lhs.count);
+                T nr = static_cast<T>(rhs.count);
+                T delta = rhs.mean - lhs.mean;
+                res.mean = lhs.mean + delta * nr / n;
+                res.m2 = lhs.m2 + rhs.m2 + delta * delta * nl * nr / n;
+                res.min = rhs.min < lhs.min ? rhs.min : lhs.min;
+                res.max = rhs.max > lhs.max ? rhs.max : lhs.max;
+                return res;
+            }
+        };
+
+        template <class E>
+        inline auto make_stats_functor()
+        {
+            using value_type = stats_value_type_t<typename std::decay_t<E>::value_type>;
+            return make_xreducer_functor(stats_reduce<value_type>(), stats_init<value_type>(), stats_merge<value_type>());
+        }
+
+        template <class S>
+        struct stats_variance
+        {
+            using argument_type = S;
+            using result_type = typename S::value_type;
+
+            result_type operator()(const S& s) const
+            {
+                return s.variance();
+            }
+
+            template <class U>
+            struct rebind
+            {
+                using type = stats_variance<U>;
+            };
+        };
+
+        template <class S>
+        struct stats_stddev
+        {
+            using argument_type = S;
+            using result_type = typename S::value_type;
+
+            result_type operator()(const S& s) const
+            {
+                return s.stddev();
+            }
+
+            template <class U>
+            struct rebind
+            {
+                using type = stats_stddev<U>;
+            };
+        };
+
+        // xstats has no arithmetic operators, the value type of the
+        // function cannot be deduced by make_xfunction.
+        template <template <class> class F, class R>
+        inline auto make_stats_function(R&& r) noexcept
+        {
+            using functor_type = F<xvalue_type_t<std::decay_t<R>>>;
+            using type = xfunction<functor_type, typename functor_type::result_type, const_xclosure_t<R>>;
+            return type(functor_type(), std::forward<R>(r));
+        }
+    }
+
+    /**
+     * @ingroup red_functions
+     * @brief Descriptive statistics of elements over given axes.
+     *
+     * Returns an \ref xreducer whose elements are the \ref xstats (count,
+     * mean, M2, minimum and maximum) of the elements of \em e over the given
+     * \em axes, computed in a single pass. Partial statistics are combined
+     * with the parallel formula of Chan et al., which makes the reducer
+     * suitable for every evaluation strategy.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the statistics are computed (optional)
+     * @param es evaluation strategy of the reducer
+     * @return an \ref xexpression
+     */
+    template <class E, class X, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value, int>>
+    inline auto stats(E&& e, X&& axes, ES es = ES()) noexcept
+    {
+        return reduce(detail::make_stats_functor<E>(), std::forward<E>(e), std::forward<X>(axes), es);
+    }
+
+    template <class E, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto stats(E&& e, ES es = ES()) noexcept
+    {
+        return reduce(detail::make_stats_functor<E>(), std::forward<E>(e), es);
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I, class ES = DEFAULT_STRATEGY_REDUCERS>
+    inline auto stats(E&& e, std::initializer_list<I> axes, ES es = ES()) noexcept
+    {
+        return reduce(detail::make_stats_functor<E>(), std::forward<E>(e), axes, es);
+    }
+#else
+    template <class E, class I, std::size_t N, class ES = DEFAULT_STRATEGY_REDUCERS>
+    inline auto stats(E&& e, const I (&axes)[N], ES es = ES()) noexcept
+    {
+        return reduce(detail::make_stats_functor<E>(), std::forward<E>(e), axes, es);
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Variance of elements over given axes.
+     *
+     * Returns an \ref xexpression for the population variance of elements
+     * over given \em axes, computed in a single pass by \ref stats.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the variance is computed (optional)
+     * @return an \ref xexpression
+     */
+    template <class E, class X>
+    inline auto variance(E&& e, X&& axes) noexcept
+    {
+        return detail::make_stats_function<detail::stats_variance>(stats(std::forward<E>(e), std::forward<X>(axes)));
+    }
+
+    template <class E>
+    inline auto variance(E&& e) noexcept
+    {
+        return detail::make_stats_function<detail::stats_variance>(stats(std::forward<E>(e)));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto variance(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        return detail::make_stats_function<detail::stats_variance>(stats(std::forward<E>(e), axes));
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto variance(E&& e, const I (&axes)[N]) noexcept
+    {
+        return detail::make_stats_function<detail::stats_variance>(stats(std::forward<E>(e), axes));
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Standard deviation of elements over given axes.
+     *
+     * Returns an \ref xexpression for the population standard deviation
+     * of elements over given \em axes, computed in a single pass by
+     * \ref stats.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the standard deviation is computed (optional)
+     * @return an \ref xexpression
+     */
+    template <class E, class X>
+    inline auto stddev(E&& e, X&& axes) noexcept
+    {
+        return detail::make_stats_function<detail::stats_stddev>(stats(std::forward<E>(e), std::forward<X>(axes)));
+    }
+
+    template <class E>
+    inline auto stddev(E&& e) noexcept
+    {
+        return detail::make_stats_function<detail::stats_stddev>(stats(std::forward<E>(e)));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto stddev(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        return detail::make_stats_function<detail::stats_stddev>(stats(std::forward<E>(e), axes));
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto stddev(E&& e, const I (&axes)[N]) noexcept
+    {
+        return detail::make_stats_function<detail::stats_stddev>(stats(std::forward<E>(e), axes));
+    }
+#endif
+
+    /****************
+     * accurate sum *
+     ****************/
+
+    namespace summation
+    {
+        struct base
+        {
+        };
+
+        /// Blocked pairwise (cascade) summation
+        struct pairwise : base
+        {
+        };
+
+        /// Compensated summation (Kahan-Babuska-Neumaier)
+        struct kahan : base
+        {
+        };
+    }
+
+    namespace detail
+    {
+        template <class T>
+        inline void neumaier_add(T& sum, T& comp, const T& x)
+        {
+            using std::abs;
+            T t = sum + x;
+            comp += (abs(sum) >= abs(x)) ? (sum - t) + x : (x - t) + sum;
+            sum = t;
+        }
+
+#ifdef XTENSOR_USE_XSIMD
+        template <class T, std::size_t N>
+        inline void neumaier_add(xsimd::batch<T, N>& sum, xsimd::batch<T, N>& comp, const xsimd::batch<T, N>& x)
+        {
+            using std::abs;
+            xsimd::batch<T, N> t = sum + x;
+            comp += xsimd::select(abs(sum) >= abs(x), (sum - t) + x, (x - t) + sum);
+            sum = t;
+        }
+#endif
+
+        /**
+         * Compensated sum, contiguous sequences are summed in simd
+         * lanes that each hold their own compensation.
+         */
+        template <class T>
+        class xkahan_sum
+        {
+        public:
+
+            void add(const T& x) noexcept;
+            void add(const T* first, std::size_t n) noexcept;
+            T result() const noexcept;
+
+        private:
+
+            T m_sum = T(0);
+            T m_comp = T(0);
+        };
+
+        template <class T>
+        inline void xkahan_sum<T>::add(const T& x) noexcept
+        {
+            neumaier_add(m_sum, m_comp, x);
+        }
+
+        template <class T>
+        inline void xkahan_sum<T>::add(const T* first, std::size_t n) noexcept
+        {
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            std::size_t i = 0;
+            if (simd_size > 1 && n >= simd_size)
+            {
+                simd_type sum(T(0));
+                simd_type comp(T(0));
+                for (; i + simd_size <= n; i += simd_size)
+                {
+                    neumaier_add(sum, comp, simd_type(xsimd::load_simd<T>(first + i, xsimd::unaligned_mode())));
+                }
+                T sum_lanes[simd_size];
+                T comp_lanes[simd_size];
+                xsimd::store_simd<T>(sum_lanes, sum, xsimd::unaligned_mode());
+                xsimd::store_simd<T>(comp_lanes, comp, xsimd::unaligned_mode());
+                for (std::size_t j = 0; j < simd_size; ++j)
+                {
+                    add(sum_lanes[j]);
+                }
+                for (std::size_t j = 0; j < simd_size; ++j)
+                {
+                    add(comp_lanes[j]);
+                }
+            }
+            for (; i < n; ++i)
+            {
+                add(first[i]);
+            }
+        }
+
+        template <class T>
+        inline T xkahan_sum<T>::result() const noexcept
+        {
+            return m_sum + m_comp;
+        }
+
+        /**
+         * Pairwise sum: the values are summed by blocks, with simd
+         * accumulators for contiguous sequences, and the block sums
+         * are combined in a binary cascade.
+         */
+        template <class T>
+        class xpairwise_sum
+        {
+        public:
+
+            static constexpr std::size_t block_size = 128;
+
+            void add(const T& x) noexcept;
+            void add(const T* first, std::size_t n) noexcept;
+            T result() const noexcept;
+
+        private:
+
+            void push(T x) noexcept;
+
+            std::array<T, 64> m_levels = {};
+            std::uint64_t m_mask = 0;
+            T m_block = T(0);
+            std::size_t m_count = 0;
+        };
+
+        template <class T>
+        inline void xpairwise_sum<T>::add(const T& x) noexcept
+        {
+            m_block += x;
+            if (++m_count == block_size)
+            {
+                push(m_block);
+                m_block = T(0);
+                m_count = 0;
+            }
+        }
+
+        template <class T>
+        inline void xpairwise_sum<T>::add(const T* first, std::size_t n) noexcept
+        {
+            using use_simd = use_simd_reduce<std::plus<T>, T, T>;
+            for (std::size_t i = 0; i < n; i += block_size)
+            {
+                std::size_t size = std::min(block_size, n - i);
+                push(reduce_contiguous(std::plus<T>(), T(0), first + i, size, use_simd()));
+            }
+        }
+
+        template <class T>
+        inline T xpairwise_sum<T>::result() const noexcept
+        {
+            T res = m_block;
+            for (std::size_t k = 0; k < m_levels.size(); ++k)
+            {
+                if (m_mask & (std::uint64_t(1) << k))
+                {
+                    res += m_levels[k];
+                }
+            }
+            return res;
+        }
+
+        template <class T>
+        inline void xpairwise_sum<T>::push(T x) noexcept
+        {
+            std::size_t k = 0;
+            for (; m_mask & (std::uint64_t(1) << k); ++k)
+            {
+                x = m_levels[k] + x;
+                m_mask &= ~(std::uint64_t(1) << k);
+            }
+            m_levels[k] = x;
+            m_mask |= std::uint64_t(1) << k;
+        }
+
+        /**
+         * Compensated sums of the elements of n contiguous columns, the rows
+         * are added with simd instructions, one simd lane per column.
+         */
+        template <class T>
+        class xkahan_sum_rows
+        {
+        public:
+
+            explicit xkahan_sum_rows(std::size_t n);
+
+            void add(const T* row) noexcept;
+            void result(T* out) const noexcept;
+
+        private:
+
+            std::vector<T> m_sum;
+            std::vector<T> m_comp;
+        };
+
+        template <class T>
+        inline xkahan_sum_rows<T>::xkahan_sum_rows(std::size_t n)
+            : m_sum(n, T(0)), m_comp(n, T(0))
+        {
+        }
+
+        template <class T>
+        inline void xkahan_sum_rows<T>::add(const T* row) noexcept
+        {
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            std::size_t n = m_sum.size();
+            T* sum = m_sum.data();
+            T* comp = m_comp.data();
+            std::size_t i = 0;
+            if (simd_size > 1)
+            {
+                for (; i + simd_size <= n; i += simd_size)
+                {
+                    simd_type s = xsimd::load_simd<T>(sum + i, xsimd::unaligned_mode());
+                    simd_type c = xsimd::load_simd<T>(comp + i, xsimd::unaligned_mode());
+                    neumaier_add(s, c, simd_type(xsimd::load_simd<T>(row + i, xsimd::unaligned_mode())));
+                    xsimd::store_simd<T>(sum + i, s, xsimd::unaligned_mode());
+                    xsimd::store_simd<T>(comp + i, c, xsimd::unaligned_mode());
+                }
+            }
+            for (; i < n; ++i)
+            {
+                neumaier_add(sum[i], comp[i], row[i]);
+            }
+        }
+
+        template <class T>
+        inline void xkahan_sum_rows<T>::result(T* out) const noexcept
+        {
+            for (std::size_t i = 0; i < m_sum.size(); ++i)
+            {
+                out[i] = m_sum[i] + m_comp[i];
+            }
+        }
+
+        /**
+         * Pairwise sums of the elements of n contiguous columns: the rows
+         * are added to the blocks with simd instructions, and the blocks of
+         * all the columns go through the cascade together.
+         */
+        template <class T>
+        class xpairwise_sum_rows
+        {
+        public:
+
+            static constexpr std::size_t block_size = xpairwise_sum<T>::block_size;
+
+            explicit xpairwise_sum_rows(std::size_t n);
+
+            void add(const T* row) noexcept;
+            void result(T* out) const noexcept;
+
+        private:
+
+            using use_simd = use_simd_reduce<std::plus<T>, T, T>;
+
+            void push();
+
+            std::array<std::vector<T>, 64> m_levels;
+            std::uint64_t m_mask = 0;
+            std::vector<T> m_block;
+            std::size_t m_count = 0;
+        };
+
+        template <class T>
+        inline xpairwise_sum_rows<T>::xpairwise_sum_rows(std::size_t n)
+            : m_block(n, T(0))
+        {
+        }
+
+        template <class T>
+        inline void xpairwise_sum_rows<T>::add(const T* row) noexcept
+        {
+            transform_contiguous(std::plus<T>(), m_block.data(), row, m_block.size(), use_simd());
+            if (++m_count == block_size)
+            {
+                push();
+                std::fill(m_block.begin(), m_block.end(), T(0));
+                m_count = 0;
+            }
+        }
+
+        template <class T>
+        inline void xpairwise_sum_rows<T>::result(T* out) const noexcept
+        {
+            std::copy(m_block.cbegin(), m_block.cend(), out);
+            for (std::size_t k = 0; k < m_levels.size(); ++k)
+            {
+                if (m_mask & (std::uint64_t(1) << k))
+                {
+                    transform_contiguous(std::plus<T>(), out, m_levels[k].data(), m_block.size(), use_simd());
+                }
+            }
+        }
+
+        template <class T>
+        inline void xpairwise_sum_rows<T>::push()
+        {
+            std::size_t k = 0;
+            for (; m_mask & (std::uint64_t(1) << k); ++k)
+            {
+                transform_contiguous(std::plus<T>(), m_block.data(), m_levels[k].data(), m_block.size(), use_simd());
+                m_mask &= ~(std::uint64_t(1) << k);
+            }
+            m_levels[k].assign(m_block.cbegin(), m_block.cend());
+            m_mask |= std::uint64_t(1) << k;
+        }
+
+        template <class T, class M>
+        struct xsummation_accumulator;
+
+        template <class T>
+        struct xsummation_accumulator<T, summation::pairwise>
+        {
+            using type = xpairwise_sum<T>;
+            using rows_type = xpairwise_sum_rows<T>;
+        };
+
+        template <class T>
+        struct xsummation_accumulator<T, summation::kahan>
+        {
+            using type = xkahan_sum<T>;
+            using rows_type = xkahan_sum_rows<T>;
+        };
+
+        /**
+         * Accurate sums over strided reduced dimensions when the innermost
+         * kept dimension is contiguous: columns of that dimension are summed
+         * together, their values in a reduced position forming a contiguous
+         * row added lane-wise to their accumulators.
+         */
+        template <class T, class M>
+        inline void fsum_columns(const T* data, T* out, const xreduction_spaces& spaces)
+        {
+            using rows_type = typename xsummation_accumulator<T, M>::rows_type;
+            using size_type = std::size_t;
+            constexpr size_type column_block = 256;
+
+            xreduction_spaces::shape_type outer_shape = spaces.kept_shape;
+            xreduction_spaces::strides_type outer_strides = spaces.kept_strides;
+            size_type row_size = outer_shape.back();
+            outer_shape.pop_back();
+            outer_strides.pop_back();
+            size_type n_column_blocks = (row_size + column_block - 1) / column_block;
+            size_type n_tasks = (spaces.kept_size / row_size) * n_column_blocks;
+
+            size_type task_size = column_block * std::max(spaces.reduced_size, size_type(1));
+            size_type grain = std::max(size_type(XTENSOR_PARALLEL_GRAIN_SIZE) / task_size, size_type(1));
+            parallel_for(0, n_tasks, grain, [&](size_type first, size_type last) {
+                for (size_type t = first; t < last; ++t)
+                {
+                    size_type o = t / n_column_blocks;
+                    size_type col = (t % n_column_blocks) * column_block;
+                    size_type n_cols = std::min(column_block, row_size - col);
+                    xoffset_counter outer(outer_shape, outer_strides, o);
+                    const T* p = data + outer.offset() + static_cast<std::ptrdiff_t>(col);
+                    rows_type acc(n_cols);
+                    xoffset_counter reduced(spaces.reduced_shape, spaces.reduced_strides, 0);
+                    for (size_type r = 0; r < spaces.reduced_size; ++r, reduced.next())
+                    {
+                        acc.add(p + reduced.offset());
+                    }
+                    acc.result(out + o * row_size + col);
+                }
+            });
+        }
+
+        template <class E, class X, class M>
+        inline auto fsum_impl(const E& e, const X& axes, M, std::true_type)
+        {
+            using value_type = typename E::value_type;
+            using accumulator_type = typename xsummation_accumulator<value_type, M>::type;
+            using size_type = std::size_t;
+            static_assert(std::is_floating_point<value_type>::value, "fsum requires floating point values");
+
+            xreduction_spaces spaces = make_reduction_spaces(e, axes);
+            xarray<value_type> result(spaces.kept_shape);
+
+            // Reduced elements are summed by contiguous rows when the
+            // innermost reduced dimension is contiguous.
+            bool by_rows = !spaces.reduced_shape.empty() && spaces.reduced_strides.back() == 1;
+            size_type row_size = by_rows ? spaces.reduced_shape.back() : 1;
+            xreduction_spaces::shape_type outer_shape = spaces.reduced_shape;
+            xreduction_spaces::strides_type outer_strides = spaces.reduced_strides;
+            if (by_rows)
+            {
+                outer_shape.pop_back();
+                outer_strides.pop_back();
+            }
+            size_type n_rows = row_size == 0 ? 0 : spaces.reduced_size / row_size;
+
+            const value_type* data = e.raw_data() + e.raw_data_offset();
+            value_type* out = result.raw_data();
+            if (!by_rows && !spaces.kept_shape.empty() && spaces.kept_shape.back() > 1 &&
+                spaces.kept_strides.back() == 1 && spaces.reduced_size != 0)
+            {
+                fsum_columns<value_type, M>(data, out, spaces);
+                return result;
+            }
+
+            size_type grain = std::max(size_type(XTENSOR_PARALLEL_GRAIN_SIZE) / std::max(spaces.reduced_size, size_type(1)), size_type(1));
+            parallel_for(0, spaces.kept_size, grain, [&](size_type first, size_type last) {
+                xoffset_counter kept(spaces.kept_shape, spaces.kept_strides, first);
+                for (size_type o = first; o < last; ++o, kept.next())
+                {
+                    const value_type* p = data + kept.offset();
+                    accumulator_type acc;
+                    xoffset_counter outer(outer_shape, outer_strides, 0);
+                    for (size_type r = 0; r < n_rows; ++r, outer.next())
+                    {
+                        if (by_rows)
+                        {
+                            acc.add(p + outer.offset(), row_size);
+                        }
+                        else
+                        {
+                            acc.add(p[outer.offset()]);
+                        }
+                    }
+                    out[o] = acc.result();
+                }
+            });
+            return result;
+        }
+
+        template <class E, class X, class M>
+        inline auto fsum_impl(const E& e, const X& axes, M m, std::false_type)
+        {
+            xarray<typename E::value_type> tmp = e;
+            return fsum_impl(tmp, axes, m, std::true_type());
+        }
+
+        template <class E, class X, class M>
+        inline auto fsum_impl(const E& e, const X& axes, M m)
+        {
+            return fsum_impl(e, axes, m, has_memory_span<E>());
+        }
+    }
+
+    /**
+     * @ingroup red_functions
+     * @brief Accurate sum of elements over given axes.
+     *
+     * Returns an \ref xarray holding the sum of the elements of \em e over
+     * the given \em axes, computed in the value type of \em e with an
+     * accurate summation method: summation::pairwise (default), whose error
+     * grows with the logarithm of the number of elements, or summation::kahan,
+     * whose error does not depend on it. Both are vectorized.
+     * @param e an \ref xexpression of floating point values
+     * @param axes the axes along which the sum is performed (optional)
+     * @param m the summation method
+     * @return an \ref xarray
+     */
+    template <class E, class X, class M = summation::pairwise,
+              class = std::enable_if_t<!std::is_base_of<summation::base, std::decay_t<X>>::value, int>>
+    inline auto fsum(E&& e, X&& axes, M m = M())
+    {
+        return detail::fsum_impl(e, axes, m);
+    }
+
+    template <class E, class M = summation::pairwise,
+              class = std::enable_if_t<std::is_base_of<summation::base, M>::value, int>>
+    inline auto fsum(E&& e, M m = M())
+    {
+        dynamic_shape<std::size_t> axes(e.dimension());
+        std::iota(axes.begin(), axes.end(), std::size_t(0));
+        return detail::fsum_impl(e, axes, m);
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I, class M = summation::pairwise>
+    inline auto fsum(E&& e, std::initializer_list<I> axes, M m = M())
+    {
+        using axes_type = std::vector<std::size_t>;
+        return detail::fsum_impl(e, xtl::forward_sequence<axes_type>(axes), m);
+    }
+#else
+    template <class E, class I, std::size_t N, class M = summation::pairwise>
+    inline auto fsum(E&& e, const I (&axes)[N], M m = M())
+    {
+        using axes_type = std::array<std::size_t, N>;
+        return detail::fsum_impl(e, xtl::forward_sequence<axes_type>(axes), m);
+    }
+#endif
+
     /**
      * @defgroup acc_functions accumulating functions
      */
@@ -1628,20 +2480,22 @@ INT_SPECIALIZATION_IMPL(FUNC_NAME, RETURN_VAL, unsigned long long);
      * \em axis (or flattened).
      * @param e an \ref xexpression
      * @param axis the axes along which the cumulative sum is computed (optional)
+     * @param es evaluation strategy of the accumulation, immediate (default) or parallel (optional)
      * @return an \ref xarray<T>
      */
-    template <class E>
-    inline auto cumsum(E&& e, std::size_t axis) noexcept
+    template <class E, class ES = DEFAULT_STRATEGY_ACCUMULATORS>
+    inline auto cumsum(E&& e, std::size_t axis, ES es = ES()) noexcept
     {
         using result_type = big_promote_type_t<typename std::decay_t<E>::value_type>;
-        return accumulate(std::plus<result_type>(), std::forward<E>(e), axis);
+        return accumulate(std::plus<result_type>(), std::forward<E>(e), axis, es);
     }
 
-    template <class E>
-    inline auto cumsum(E&& e) noexcept
+    template <class E, class ES = DEFAULT_STRATEGY_ACCUMULATORS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto cumsum(E&& e, ES es = ES()) noexcept
     {
         using result_type = big_promote_type_t<typename std::decay_t<E>::value_type>;
-        return accumulate(std::plus<result_type>(), std::forward<E>(e));
+        return accumulate(std::plus<result_type>(), std::forward<E>(e), es);
     }
 
     /**
@@ -1652,20 +2506,22 @@ INT_SPECIALIZATION_IMPL(FUNC_NAME, RETURN_VAL, unsigned long long);
      * \em axis (or flattened).
      * @param e an \ref xexpression
      * @param axis the axes along which the cumulative product is computed (optional)
+     * @param es evaluation strategy of the accumulation, immediate (default) or parallel (optional)
      * @return an \ref xarray<T>
      */
-    template <class E>
-    inline auto cumprod(E&& e, std::size_t axis) noexcept
+    template <class E, class ES = DEFAULT_STRATEGY_ACCUMULATORS>
+    inline auto cumprod(E&& e, std::size_t axis, ES es = ES()) noexcept
     {
         using result_type = big_promote_type_t<typename std::decay_t<E>::value_type>;
-        return accumulate(std::multiplies<result_type>(), std::forward<E>(e), axis);
+        return accumulate(std::multiplies<result_type>(), std::forward<E>(e), axis, es);
     }
 
-    template <class E>
-    inline auto cumprod(E&& e) noexcept
+    template <class E, class ES = DEFAULT_STRATEGY_ACCUMULATORS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    inline auto cumprod(E&& e, ES es = ES()) noexcept
     {
         using result_type = big_promote_type_t<typename std::decay_t<E>::value_type>;
-        return accumulate(std::multiplies<result_type>(), std::forward<E>(e));
+        return accumulate(std::multiplies<result_type>(), std::forward<E>(e), es);
     }
 }
 
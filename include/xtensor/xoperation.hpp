@@ -10,6 +10,7 @@
 #define XTENSOR_OPERATION_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <type_traits>
 
@@ -158,6 +159,45 @@ namespace xt
             };
         };
 
+        /* Fused multiply-add functors, used to contract a multiplication
+           and an addition or a subtraction into a single rounding. The
+           product is always arg1 * arg2. */
+#define FUSED_MULTIPLY_FUNCTOR(NAME, ARG1, ARG3)                                  \
+        template <class T>                                                        \
+        struct NAME                                                               \
+        {                                                                         \
+            using first_argument_type = T;                                        \
+            using second_argument_type = T;                                       \
+            using third_argument_type = T;                                        \
+            using result_type = T;                                                \
+            using simd_value_type = xsimd::simd_type<T>;                          \
+            using simd_result_type = simd_value_type;                             \
+            result_type operator()(const T& arg1, const T& arg2,                  \
+                                   const T& arg3) const                           \
+            {                                                                     \
+                using std::fma;                                                   \
+                return fma(ARG1, arg2, ARG3);                                     \
+            }                                                                     \
+            simd_result_type simd_apply(const simd_value_type& arg1,              \
+                                        const simd_value_type& arg2,              \
+                                        const simd_value_type& arg3) const        \
+            {                                                                     \
+                using std::fma;                                                   \
+                return fma(ARG1, arg2, ARG3);                                     \
+            }                                                                     \
+            template <class U>                                                    \
+            struct rebind                                                         \
+            {                                                                     \
+                using type = NAME<U>;                                             \
+            };                                                                    \
+        }
+
+        FUSED_MULTIPLY_FUNCTOR(multiply_plus, arg1, arg3);
+        FUSED_MULTIPLY_FUNCTOR(multiply_minus, arg1, -arg3);
+        FUSED_MULTIPLY_FUNCTOR(negate_multiply_plus, -arg1, arg3);
+
+#undef FUSED_MULTIPLY_FUNCTOR
+
         template <class R>
         struct cast
         {
@@ -261,6 +301,133 @@ namespace xt
                                                            xfunction_type<F, E...>>::type;
     }
 
+    /*******************
+     * fma contraction *
+     *******************/
+
+    namespace detail
+    {
+        template <class E>
+        struct is_contractible_product : std::false_type
+        {
+        };
+
+        template <class T, class CT1, class CT2>
+        struct is_contractible_product<xfunction<multiplies<T>, T, CT1, CT2>> : std::is_floating_point<T>
+        {
+        };
+
+        /**
+         * Builds the function F(e1, e2) where F is plus or minus. When
+         * XTENSOR_ENABLE_FMA_CONTRACTION is defined and one of e1 or e2
+         * is a floating point multiplication, the multiplication and F
+         * are contracted into a single fused multiply-add function whose
+         * arguments are the factors of the multiplication and the other
+         * operand of F.
+         */
+        template <template <class...> class F, class E1, class E2, class = void>
+        struct xcontraction
+        {
+            using type = typename xfunction_type<F, E1, E2>::type;
+
+            static type make(E1&& e1, E2&& e2) noexcept
+            {
+                return make_xfunction<F>(std::forward<E1>(e1), std::forward<E2>(e2));
+            }
+        };
+
+#ifdef XTENSOR_ENABLE_FMA_CONTRACTION
+
+        template <template <class...> class G, class M, class E>
+        struct xfused_function_type;
+
+        template <template <class...> class G, class T, class CT1, class CT2, class E>
+        struct xfused_function_type<G, xfunction<multiplies<T>, T, CT1, CT2>, E>
+        {
+            using type = xfunction<G<T>, T, CT1, CT2, const_xclosure_t<E>>;
+        };
+
+        template <template <class...> class G, class M, class E>
+        inline auto make_fused_xfunction(M&& m, E&& e) noexcept
+        {
+            using type = typename xfused_function_type<G, std::decay_t<M>, E>::type;
+            using functor_type = typename type::functor_type;
+            auto&& args = std::forward<M>(m).arguments();
+            return type(functor_type(),
+                        std::get<0>(std::forward<decltype(args)>(args)),
+                        std::get<1>(std::forward<decltype(args)>(args)),
+                        std::forward<E>(e));
+        }
+
+        template <class M, class E>
+        using enable_contraction_t = std::enable_if_t<is_contractible_product<std::decay_t<M>>::value &&
+                                                      std::is_same<xexpression_tag_t<M, E>, xtensor_expression_tag>::value &&
+                                                      std::is_same<common_value_type_t<std::decay_t<M>, std::decay_t<E>>,
+                                                                   typename std::decay_t<M>::value_type>::value>;
+
+        template <class M, class E, class = void>
+        struct contraction_enabled : std::false_type
+        {
+        };
+
+        template <class M, class E>
+        struct contraction_enabled<M, E, void_t<enable_contraction_t<M, E>>> : std::true_type
+        {
+        };
+
+        template <template <class...> class G, class M, class E>
+        struct xfused_contraction
+        {
+            using type = typename xfused_function_type<G, std::decay_t<M>, E>::type;
+        };
+
+        template <class E1, class E2>
+        struct xcontraction<plus, E1, E2, enable_contraction_t<E1, E2>>
+            : xfused_contraction<multiply_plus, E1, E2>
+        {
+            static auto make(E1&& e1, E2&& e2) noexcept
+            {
+                return make_fused_xfunction<multiply_plus>(std::forward<E1>(e1), std::forward<E2>(e2));
+            }
+        };
+
+        template <class E1, class E2>
+        struct xcontraction<plus, E1, E2, std::enable_if_t<!contraction_enabled<E1, E2>::value, enable_contraction_t<E2, E1>>>
+            : xfused_contraction<multiply_plus, E2, E1>
+        {
+            static auto make(E1&& e1, E2&& e2) noexcept
+            {
+                return make_fused_xfunction<multiply_plus>(std::forward<E2>(e2), std::forward<E1>(e1));
+            }
+        };
+
+        template <class E1, class E2>
+        struct xcontraction<minus, E1, E2, enable_contraction_t<E1, E2>>
+            : xfused_contraction<multiply_minus, E1, E2>
+        {
+            static auto make(E1&& e1, E2&& e2) noexcept
+            {
+                return make_fused_xfunction<multiply_minus>(std::forward<E1>(e1), std::forward<E2>(e2));
+            }
+        };
+
+        template <class E1, class E2>
+        struct xcontraction<minus, E1, E2, std::enable_if_t<!contraction_enabled<E1, E2>::value, enable_contraction_t<E2, E1>>>
+            : xfused_contraction<negate_multiply_plus, E2, E1>
+        {
+            static auto make(E1&& e1, E2&& e2) noexcept
+            {
+                return make_fused_xfunction<negate_multiply_plus>(std::forward<E2>(e2), std::forward<E1>(e1));
+            }
+        };
+
+#endif
+
+        template <template <class...> class F, class E1, class E2>
+        using xcontraction_type_t = typename std::enable_if_t<has_xexpression<std::decay_t<E1>, std::decay_t<E2>>::value,
+                                                              xcontraction<F, E1, E2>>::type;
+    }
+
 #undef UNARY_OPERATOR_FUNCTOR
 #undef UNARY_BOOL_OPERATOR_FUNCTOR
 #undef UNARY_OPERATOR_FUNCTOR_IMPL
@@ -320,9 +487,9 @@ namespace xt
     */
     template <class E1, class E2>
     inline auto operator+(E1&& e1, E2&& e2) noexcept
-        -> detail::xfunction_type_t<detail::plus, E1, E2>
+        -> detail::xcontraction_type_t<detail::plus, E1, E2>
     {
-        return detail::make_xfunction<detail::plus>(std::forward<E1>(e1), std::forward<E2>(e2));
+        return detail::xcontraction<detail::plus, E1, E2>::make(std::forward<E1>(e1), std::forward<E2>(e2));
     }
 
     /**
@@ -337,9 +504,9 @@ namespace xt
     */
     template <class E1, class E2>
     inline auto operator-(E1&& e1, E2&& e2) noexcept
-        -> detail::xfunction_type_t<detail::minus, E1, E2>
+        -> detail::xcontraction_type_t<detail::minus, E1, E2>
     {
-        return detail::make_xfunction<detail::minus>(std::forward<E1>(e1), std::forward<E2>(e2));
+        return detail::xcontraction<detail::minus, E1, E2>::make(std::forward<E1>(e1), std::forward<E2>(e2));
     }
 
     /**
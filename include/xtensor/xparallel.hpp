@@ -0,0 +1,369 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XTENSOR_PARALLEL_HPP
+#define XTENSOR_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#ifdef XTENSOR_USE_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#include "xtensor_config.hpp"
+
+namespace xt
+{
+
+    /*********************
+     * Threading control *
+     *********************/
+
+    std::size_t get_num_threads() noexcept;
+    void set_num_threads(std::size_t n) noexcept;
+
+    namespace detail
+    {
+        template <class F>
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain_size, F&& f);
+    }
+
+#ifdef XTENSOR_USE_THREADS
+
+    /****************
+     * xthread_pool *
+     ****************/
+
+    namespace detail
+    {
+        /**
+         * @class xthread_pool
+         * @brief Persistent pool of worker threads.
+         *
+         * The workers are started on demand and live until the end of the
+         * program. The pool only grows: requesting less workers than the
+         * pool already holds simply leaves some of them idle.
+         */
+        class xthread_pool
+        {
+        public:
+
+            using task_type = std::function<void()>;
+
+            xthread_pool() = default;
+            ~xthread_pool();
+
+            xthread_pool(const xthread_pool&) = delete;
+            xthread_pool& operator=(const xthread_pool&) = delete;
+
+            void reserve(std::size_t n);
+            void push(task_type task);
+
+            static xthread_pool& instance();
+            static bool& in_worker() noexcept;
+
+        private:
+
+            void work();
+
+            std::vector<std::thread> m_workers;
+            std::deque<task_type> m_tasks;
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            bool m_stop = false;
+        };
+
+        inline xthread_pool::~xthread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            for (auto& w : m_workers)
+            {
+                w.join();
+            }
+        }
+
+        inline void xthread_pool::reserve(std::size_t n)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (m_workers.size() < n)
+            {
+                m_workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        inline void xthread_pool::push(task_type task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_cv.notify_one();
+        }
+
+        inline xthread_pool& xthread_pool::instance()
+        {
+            static xthread_pool pool;
+            return pool;
+        }
+
+        inline bool& xthread_pool::in_worker() noexcept
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+
+        inline void xthread_pool::work()
+        {
+            in_worker() = true;
+            while (true)
+            {
+                task_type task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                    if (m_stop && m_tasks.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        inline std::atomic<std::size_t>& num_threads_storage() noexcept
+        {
+            static std::atomic<std::size_t> n(std::max(std::size_t(1), std::size_t(std::thread::hardware_concurrency())));
+            return n;
+        }
+    }
+
+    /************************************
+     * Threading control implementation *
+     ************************************/
+
+    /**
+     * Returns the maximal number of threads used by the parallel
+     * algorithms of xtensor, including the calling thread.
+     */
+    inline std::size_t get_num_threads() noexcept
+    {
+        return detail::num_threads_storage().load();
+    }
+
+    /**
+     * Sets the maximal number of threads used by the parallel
+     * algorithms of xtensor. A value of 1 disables multithreading,
+     * a value of 0 restores the number of hardware threads.
+     * @param n the number of threads
+     */
+    inline void set_num_threads(std::size_t n) noexcept
+    {
+        if (n == 0)
+        {
+            n = std::max(std::size_t(1), std::size_t(std::thread::hardware_concurrency()));
+        }
+        detail::num_threads_storage().store(n);
+    }
+
+    namespace detail
+    {
+        /**
+         * Calls f(chunk_begin, chunk_end) on disjoint chunks covering
+         * [begin, end). Chunks hold at least grain_size elements; the
+         * calling thread processes the first one and waits for the others.
+         * Nested calls and small ranges run serially. The first exception
+         * thrown by a chunk is rethrown in the calling thread.
+         */
+        template <class F>
+        inline void parallel_for(std::size_t begin, std::size_t end, std::size_t grain_size, F&& f)
+        {
+            std::size_t size = end > begin ? end - begin : 0;
+            grain_size = std::max(grain_size, std::size_t(1));
+            std::size_t n_chunks = std::min(get_num_threads(), size / grain_size);
+            if (n_chunks < 2 || xthread_pool::in_worker())
+            {
+                if (size != 0)
+                {
+                    f(begin, end);
+                }
+                return;
+            }
+
+            struct shared_state
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::size_t remaining;
+                std::exception_ptr error;
+            };
+
+            shared_state state;
+            state.remaining = n_chunks - 1;
+            std::size_t chunk_size = size / n_chunks;
+            std::size_t extra = size % n_chunks;
+
+            auto chunk_bounds = [begin, chunk_size, extra](std::size_t i) {
+                std::size_t first = begin + i * chunk_size + std::min(i, extra);
+                return std::make_pair(first, first + chunk_size + (i < extra ? 1 : 0));
+            };
+
+            xthread_pool& pool = xthread_pool::instance();
+            pool.reserve(n_chunks - 1);
+            for (std::size_t i = 1; i < n_chunks; ++i)
+            {
+                auto bounds = chunk_bounds(i);
+                pool.push([&state, &f, bounds]() {
+                    std::exception_ptr error;
+                    try
+                    {
+                        f(bounds.first, bounds.second);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    if (error && !state.error)
+                    {
+                        state.error = error;
+                    }
+                    if (--state.remaining == 0)
+                    {
+                        state.cv.notify_one();
+                    }
+                });
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                auto bounds = chunk_bounds(0);
+                f(bounds.first, bounds.second);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.cv.wait(lock, [&state]() { return state.remaining == 0; });
+            if (!error)
+            {
+                error = state.error;
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+#else
+
+    inline std::size_t get_num_threads() noexcept
+    {
+        return 1;
+    }
+
+    inline void set_num_threads(std::size_t) noexcept
+    {
+    }
+
+    namespace detail
+    {
+        template <class F>
+        inline void parallel_for(std::size_t begin, std::size_t end, std::size_t, F&& f)
+        {
+            if (end > begin)
+            {
+                f(begin, end);
+            }
+        }
+    }
+
+#endif
+
+    /**********
+     * chunks *
+     **********/
+
+    namespace detail
+    {
+        /**
+         * Consecutive chunks of the indices [0, size), all made of length
+         * indices except the last one, which may be shorter.
+         */
+        struct xchunks
+        {
+            std::size_t size;
+            std::size_t count;
+            std::size_t length;
+
+            std::size_t first(std::size_t c) const noexcept;
+            std::size_t last(std::size_t c) const noexcept;
+        };
+
+        inline std::size_t xchunks::first(std::size_t c) const noexcept
+        {
+            return c * length;
+        }
+
+        inline std::size_t xchunks::last(std::size_t c) const noexcept
+        {
+            return std::min(size, (c + 1) * length);
+        }
+
+        /**
+         * Splits [0, size) in one chunk per thread, each chunk holding at
+         * least grain_size indices. A single chunk is returned when the
+         * range is too small to be split.
+         */
+        inline xchunks split_chunks(std::size_t size, std::size_t grain_size = XTENSOR_PARALLEL_GRAIN_SIZE)
+        {
+            std::size_t count = std::min(get_num_threads(), size / std::max(grain_size, std::size_t(1)));
+            count = std::max(count, std::size_t(1));
+            std::size_t length = (size + count - 1) / count;
+            if (length != 0)
+            {
+                count = (size + length - 1) / length;
+            }
+            return {size, count, length};
+        }
+
+        /**
+         * Calls f(c, first, last) on each chunk c of chunks, the chunks
+         * being distributed between threads.
+         */
+        template <class F>
+        inline void parallel_for_chunks(const xchunks& chunks, F&& f)
+        {
+            parallel_for(0, chunks.count, 1, [&chunks, &f](std::size_t begin, std::size_t end) {
+                for (std::size_t c = begin; c != end; ++c)
+                {
+                    f(c, chunks.first(c), chunks.last(c));
+                }
+            });
+        }
+    }
+}
+
+#endif
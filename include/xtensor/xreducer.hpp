@@ -11,24 +11,28 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
 #include <utility>
-#ifdef X_OLD_CLANG
 #include <vector>
-#endif
 
 #include "xtl/xfunctional.hpp"
 #include "xtl/xsequence.hpp"
 
+#include "xassign.hpp"
 #include "xbuilder.hpp"
+#include "xcached.hpp"
 #include "xexpression.hpp"
 #include "xgenerator.hpp"
 #include "xiterable.hpp"
+#include "xparallel.hpp"
 #include "xreducer.hpp"
+#include "xtensor_simd.hpp"
 #include "xutils.hpp"
 
 namespace xt
@@ -40,238 +44,845 @@ namespace xt
 #define DEFAULT_STRATEGY_REDUCERS evaluation_strategy::lazy
 
     template <class F, class E, class X, class ES = DEFAULT_STRATEGY_REDUCERS,
-              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value, int>>
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value &&
+                                       std::is_base_of<evaluation_strategy::base, ES>::value, int>>
     auto reduce(F&& f, E&& e, X&& axes, ES es = ES()) noexcept;
 
     template <class F, class E, class ES = DEFAULT_STRATEGY_REDUCERS,
               class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
     auto reduce(F&& f, E&& e, ES es = ES()) noexcept;
 
+    template <class F, class E, class X, class R, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, std::decay_t<X>>::value &&
+                                       !std::is_base_of<evaluation_strategy::base, R>::value, int>>
+    R& reduce(F&& f, E&& e, X&& axes, R& out, ES es = ES());
+
 #ifdef X_OLD_CLANG
     template <class F, class E, class I>
     auto reduce(F&& f, E&& e, std::initializer_list<I> axes) noexcept;
+
+    template <class F, class E, class I, class R>
+    R& reduce(F&& f, E&& e, std::initializer_list<I> axes, R& out);
 #else
-    template <class F, class E, class I, std::size_t N, class ES = DEFAULT_STRATEGY_REDUCERS>
+    template <class F, class E, class I, std::size_t N, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
     auto reduce(F&& f, E&& e, const I (&axes)[N], ES es = ES()) noexcept;
+
+    template <class F, class E, class I, std::size_t N, class R, class ES = DEFAULT_STRATEGY_REDUCERS,
+              class = std::enable_if_t<!std::is_base_of<evaluation_strategy::base, R>::value, int>>
+    R& reduce(F&& f, E&& e, const I (&axes)[N], R& out, ES es = ES());
 #endif
 
-    template <class F, class E, class X>
-    auto reduce_immediate(F&& f, E&& e, X&& axes)
+    /***********************
+     * simd reduce kernels *
+     ***********************/
+
+    namespace detail
     {
-        using shape_type = dynamic_shape<std::size_t>;
-        using accumulate_functor = std::decay_t<decltype(std::get<0>(f))>;
-        using result_type = typename accumulate_functor::result_type;
+        /**
+         * Simd counterpart of a reducing functor. Only associative and
+         * commutative functors can be specialized, since the kernels
+         * reorder the operations.
+         */
+        template <class F>
+        struct simd_reduce_op
+        {
+            static constexpr bool value = false;
+        };
+
+        template <class T>
+        struct simd_reduce_op<std::plus<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const std::plus<T>&, const B& lhs, const B& rhs)
+            {
+                return lhs + rhs;
+            }
+        };
 
-        // retrieve functors from triple struct
-        auto acc_fct = std::get<0>(f);
-        auto init_fct = std::get<1>(f);
-        auto merge_fct = std::get<2>(f);
+        template <class T>
+        struct simd_reduce_op<std::multiplies<T>>
+        {
+            static constexpr bool value = true;
 
-        shape_type result_shape(e.dimension() - axes.size());
-        shape_type iter_shape = e.shape();
-        shape_type iter_strides(e.dimension());
+            template <class B>
+            static B apply(const std::multiplies<T>&, const B& lhs, const B& rhs)
+            {
+                return lhs * rhs;
+            }
+        };
 
-        xt::xarray<result_type, std::decay_t<E>::static_layout> result;
+        template <class T>
+        using is_simd_reducible = std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>;
+
+        /**
+         * Elements of type U are reduced in batches of type T, they
+         * are converted while being loaded.
+         */
+        template <class F, class T, class U>
+        struct use_simd_reduce
+            : std::integral_constant<bool, simd_reduce_op<F>::value && is_simd_reducible<T>::value &&
+                                           is_simd_reducible<U>::value && (xsimd::simd_traits<T>::size > 1)>
+        {
+        };
 
-        if (!std::is_sorted(axes.cbegin(), axes.cend()))
+        /**
+         * Accumulates the n contiguous elements starting at first into init.
+         * Four independent accumulators hide the latency of the operation.
+         */
+        template <class F, class T, class U>
+        inline T reduce_contiguous(const F& f, T init, const U* first, std::size_t n, std::true_type)
         {
-            throw std::runtime_error("Reducing axes should be sorted");
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            using op = simd_reduce_op<F>;
+
+            std::size_t i = 0;
+            if (n >= 4 * simd_size)
+            {
+                simd_type acc0 = xsimd::load_simd<U, T>(first, xsimd::unaligned_mode());
+                simd_type acc1 = xsimd::load_simd<U, T>(first + simd_size, xsimd::unaligned_mode());
+                simd_type acc2 = xsimd::load_simd<U, T>(first + 2 * simd_size, xsimd::unaligned_mode());
+                simd_type acc3 = xsimd::load_simd<U, T>(first + 3 * simd_size, xsimd::unaligned_mode());
+                for (i = 4 * simd_size; i + 4 * simd_size <= n; i += 4 * simd_size)
+                {
+                    acc0 = op::apply(f, acc0, xsimd::load_simd<U, T>(first + i, xsimd::unaligned_mode()));
+                    acc1 = op::apply(f, acc1, xsimd::load_simd<U, T>(first + i + simd_size, xsimd::unaligned_mode()));
+                    acc2 = op::apply(f, acc2, xsimd::load_simd<U, T>(first + i + 2 * simd_size, xsimd::unaligned_mode()));
+                    acc3 = op::apply(f, acc3, xsimd::load_simd<U, T>(first + i + 3 * simd_size, xsimd::unaligned_mode()));
+                }
+                for (; i + simd_size <= n; i += simd_size)
+                {
+                    acc0 = op::apply(f, acc0, xsimd::load_simd<U, T>(first + i, xsimd::unaligned_mode()));
+                }
+                acc0 = op::apply(f, op::apply(f, acc0, acc1), op::apply(f, acc2, acc3));
+
+                T lanes[simd_size];
+                xsimd::store_simd<T>(lanes, acc0, xsimd::unaligned_mode());
+                for (std::size_t j = 0; j < simd_size; ++j)
+                {
+                    init = f(init, lanes[j]);
+                }
+            }
+            for (; i < n; ++i)
+            {
+                init = f(init, first[i]);
+            }
+            return init;
         }
 
-        // Fast track for complete reduction
-        if (e.dimension() == axes.size())
+        template <class F, class T, class U>
+        inline T reduce_contiguous(const F& f, T init, const U* first, std::size_t n, std::false_type)
         {
-            auto begin = e.data().begin();
-            result_type tmp = init_fct(*begin);
-            ++begin;
-            result(0) = std::accumulate(begin, e.data().end(), tmp, acc_fct);
-            return result;
+            return std::accumulate(first, first + n, init, f);
         }
 
-        // axis wise reductions:
-        for (std::size_t i = 0, idx = 0; i < e.dimension(); ++i)
+        /**
+         * Assigns f(out[i], first[i]) to out[i] for the n contiguous elements
+         * of out and first.
+         */
+        template <class F, class T, class U>
+        inline void transform_contiguous(const F& f, T* out, const U* first, std::size_t n, std::true_type)
         {
-            if (std::find(axes.begin(), axes.end(), i) == axes.end())
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            using op = simd_reduce_op<F>;
+
+            std::size_t i = 0;
+            for (; i + simd_size <= n; i += simd_size)
+            {
+                simd_type res = op::apply(f, xsimd::load_simd<T>(out + i, xsimd::unaligned_mode()),
+                                          xsimd::load_simd<U, T>(first + i, xsimd::unaligned_mode()));
+                xsimd::store_simd<T>(out + i, res, xsimd::unaligned_mode());
+            }
+            for (; i < n; ++i)
             {
-                // i not in axes!
-                result_shape[idx] = e.shape()[i];
-                ++idx;
+                out[i] = f(out[i], first[i]);
             }
         }
 
-        result.resize(result_shape, e.layout());
+        template <class F, class T, class U>
+        inline void transform_contiguous(const F& f, T* out, const U* first, std::size_t n, std::false_type)
+        {
+            std::transform(out, out + n, first, out, f);
+        }
+    }
+
+    /**************************
+     * strided reduce kernels *
+     **************************/
+
+    namespace detail
+    {
+        /**
+         * Traverses a multi-dimensional index space in row-major order
+         * and maintains the offset of the current index.
+         */
+        class xoffset_counter
+        {
+        public:
+
+            using shape_type = dynamic_shape<std::size_t>;
+            using strides_type = dynamic_shape<std::ptrdiff_t>;
+
+            xoffset_counter(const shape_type& shape, const strides_type& strides, std::size_t first);
+
+            std::ptrdiff_t offset() const noexcept;
+            void next() noexcept;
+
+        private:
+
+            const shape_type& m_shape;
+            const strides_type& m_strides;
+            shape_type m_index;
+            std::ptrdiff_t m_offset;
+        };
+
+        inline xoffset_counter::xoffset_counter(const shape_type& shape, const strides_type& strides, std::size_t first)
+            : m_shape(shape), m_strides(strides), m_index(shape.size(), std::size_t(0)), m_offset(0)
+        {
+            for (std::size_t d = shape.size(); d != 0; --d)
+            {
+                m_index[d - 1] = first % shape[d - 1];
+                first /= shape[d - 1];
+                m_offset += static_cast<std::ptrdiff_t>(m_index[d - 1]) * strides[d - 1];
+            }
+        }
 
-        std::size_t ax_idx = (e.layout() == layout_type::row_major) ? axes.size() - 1 : 0;
-        std::size_t inner_loop_size = e.strides()[axes[ax_idx]];
-        std::size_t inner_stride    = e.strides()[axes[ax_idx]];
-        std::size_t outer_loop_size = e.shape()[axes[ax_idx]];
+        inline std::ptrdiff_t xoffset_counter::offset() const noexcept
+        {
+            return m_offset;
+        }
 
-        // The following code merges reduction axes "at the end" (or the beginning for col_major)
-        // together by increasing the size of the outer loop where appropriate
-        auto merge_loops = [&outer_loop_size, &e](auto it, auto end)
+        inline void xoffset_counter::next() noexcept
         {
-            auto last_ax = *it;
-            ++it;
-            for (; it != end; ++it)
+            for (std::size_t d = m_shape.size(); d != 0; --d)
             {
-                // note that we check is_sorted, so this condition is valid
-                if (std::abs(ptrdiff_t(*it) - ptrdiff_t(last_ax)) ==  1)
+                if (++m_index[d - 1] != m_shape[d - 1])
                 {
-                    last_ax = *it;
-                    outer_loop_size *= e.shape()[last_ax];
+                    m_offset += m_strides[d - 1];
+                    return;
                 }
+                m_index[d - 1] = 0;
+                m_offset -= static_cast<std::ptrdiff_t>(m_shape[d - 1] - 1) * m_strides[d - 1];
             }
-            return last_ax;
+        }
+
+        /**
+         * Kept and reduced dimensions of a strided expression.
+         */
+        struct xreduction_spaces
+        {
+            using shape_type = xoffset_counter::shape_type;
+            using strides_type = xoffset_counter::strides_type;
+
+            shape_type kept_shape;
+            strides_type kept_strides;
+            shape_type reduced_shape;
+            strides_type reduced_strides;
+            std::size_t kept_size = 1;
+            std::size_t reduced_size = 1;
+            bool reduce_inner = true;
         };
 
-        for (std::size_t i = 0, idx = 0; i < e.dimension(); ++i)
+        template <class E, class X>
+        inline xreduction_spaces make_reduction_spaces(const E& e, const X& axes)
         {
-            if (std::find(axes.begin(), axes.end(), i) == axes.end())
+            xreduction_spaces res;
+            std::ptrdiff_t min_kept = 0;
+            std::ptrdiff_t min_reduced = 0;
+            for (std::size_t i = 0; i < e.dimension(); ++i)
             {
-                // i not in axes!
-                iter_strides[i] = result.strides()[idx];
-                ++idx;
+                std::size_t n = e.shape()[i];
+                std::ptrdiff_t stride = static_cast<std::ptrdiff_t>(e.strides()[i]);
+                std::ptrdiff_t abs_stride = stride < 0 ? -stride : stride;
+                if (std::find(axes.cbegin(), axes.cend(), i) == axes.cend())
+                {
+                    res.kept_shape.push_back(n);
+                    res.kept_strides.push_back(stride);
+                    res.kept_size *= n;
+                    min_kept = (n > 1 && (min_kept == 0 || abs_stride < min_kept)) ? abs_stride : min_kept;
+                }
+                else
+                {
+                    res.reduced_shape.push_back(n);
+                    res.reduced_strides.push_back(stride);
+                    res.reduced_size *= n;
+                    min_reduced = (n > 1 && (min_reduced == 0 || abs_stride < min_reduced)) ? abs_stride : min_reduced;
+                }
             }
+            // The innermost loop runs along the most contiguous dimensions
+            res.reduce_inner = min_kept == 0 || (min_reduced != 0 && min_reduced < min_kept);
+            return res;
         }
 
-        if (e.layout() == layout_type::row_major)
+        /**
+         * Reduces the elements of the reduced index range [r_first, r_last)
+         * for the outputs [o_first, o_last), and stores the result of the
+         * output o in out[o - o_first]. When the innermost dimension of the
+         * inner loop is contiguous, its runs are handed to the simd kernels,
+         * the offset counters only walk the outer dimensions.
+         */
+        template <class F, class T, class R>
+        inline void reduce_block(const F& f, const T* data, R* out, const xreduction_spaces& spaces,
+                                 std::size_t o_first, std::size_t o_last, std::size_t r_first, std::size_t r_last)
         {
-            std::size_t last_ax = merge_loops(axes.rbegin(), axes.rend());
+            using accumulate_functor = std::decay_t<decltype(std::get<0>(f))>;
+            using init_functor = std::decay_t<decltype(std::get<1>(f))>;
+            using use_simd = std::integral_constant<bool, std::is_same<init_functor, xtl::identity>::value &&
+                                                          use_simd_reduce<accumulate_functor, R, T>::value>;
+            using shape_type = xreduction_spaces::shape_type;
+            using strides_type = xreduction_spaces::strides_type;
+
+            const auto& acc_fct = std::get<0>(f);
+            const auto& init_fct = std::get<1>(f);
+            if (spaces.reduce_inner)
+            {
+                bool by_runs = !spaces.reduced_shape.empty() && spaces.reduced_strides.back() == 1;
+                if (by_runs)
+                {
+                    std::size_t run_size = spaces.reduced_shape.back();
+                    shape_type outer_shape(spaces.reduced_shape.cbegin(), spaces.reduced_shape.cend() - 1);
+                    strides_type outer_strides(spaces.reduced_strides.cbegin(), spaces.reduced_strides.cend() - 1);
+                    xoffset_counter kept(spaces.kept_shape, spaces.kept_strides, o_first);
+                    for (std::size_t o = o_first; o < o_last; ++o, kept.next())
+                    {
+                        const T* p = data + kept.offset();
+                        xoffset_counter outer(outer_shape, outer_strides, r_first / run_size);
+                        std::size_t r = r_first;
+                        std::size_t col = r_first % run_size;
+                        const T* run = p + outer.offset() + static_cast<std::ptrdiff_t>(col);
+                        std::size_t n = std::min(run_size - col, r_last - r);
+                        R res = reduce_contiguous(acc_fct, R(init_fct(*run)), run + 1, n - 1, use_simd());
+                        for (r += n; r < r_last; r += n)
+                        {
+                            outer.next();
+                            n = std::min(run_size, r_last - r);
+                            res = reduce_contiguous(acc_fct, res, p + outer.offset(), n, use_simd());
+                        }
+                        out[o - o_first] = res;
+                    }
+                    return;
+                }
+
+                xoffset_counter kept(spaces.kept_shape, spaces.kept_strides, o_first);
+                for (std::size_t o = o_first; o < o_last; ++o, kept.next())
+                {
+                    const T* p = data + kept.offset();
+                    xoffset_counter reduced(spaces.reduced_shape, spaces.reduced_strides, r_first);
+                    R res = init_fct(p[reduced.offset()]);
+                    for (std::size_t r = r_first + 1; r < r_last; ++r)
+                    {
+                        reduced.next();
+                        res = acc_fct(res, p[reduced.offset()]);
+                    }
+                    out[o - o_first] = res;
+                }
+            }
+            else
+            {
+                bool by_runs = !spaces.kept_shape.empty() && spaces.kept_strides.back() == 1;
+                if (by_runs)
+                {
+                    std::size_t run_size = spaces.kept_shape.back();
+                    shape_type outer_shape(spaces.kept_shape.cbegin(), spaces.kept_shape.cend() - 1);
+                    strides_type outer_strides(spaces.kept_strides.cbegin(), spaces.kept_strides.cend() - 1);
+                    xoffset_counter reduced(spaces.reduced_shape, spaces.reduced_strides, r_first);
+                    for (std::size_t r = r_first; r < r_last; ++r, reduced.next())
+                    {
+                        const T* p = data + reduced.offset();
+                        xoffset_counter outer(outer_shape, outer_strides, o_first / run_size);
+                        std::size_t col = o_first % run_size;
+                        for (std::size_t o = o_first; o < o_last; outer.next())
+                        {
+                            std::size_t n = std::min(run_size - col, o_last - o);
+                            const T* run = p + outer.offset() + static_cast<std::ptrdiff_t>(col);
+                            R* res = out + (o - o_first);
+                            if (r == r_first)
+                            {
+                                std::transform(run, run + n, res, [&init_fct](const T& v) { return R(init_fct(v)); });
+                            }
+                            else
+                            {
+                                transform_contiguous(acc_fct, res, run, n, use_simd());
+                            }
+                            o += n;
+                            col = 0;
+                        }
+                    }
+                    return;
+                }
 
-            iter_shape.erase(iter_shape.begin() + ptrdiff_t(last_ax), iter_shape.end());
-            iter_strides.erase(iter_strides.begin() + ptrdiff_t(last_ax), iter_strides.end());
+                xoffset_counter reduced(spaces.reduced_shape, spaces.reduced_strides, r_first);
+                for (std::size_t r = r_first; r < r_last; ++r, reduced.next())
+                {
+                    const T* p = data + reduced.offset();
+                    xoffset_counter kept(spaces.kept_shape, spaces.kept_strides, o_first);
+                    for (std::size_t o = 0; o < o_last - o_first; ++o, kept.next())
+                    {
+                        if (r == r_first)
+                        {
+                            out[o] = init_fct(p[kept.offset()]);
+                        }
+                        else
+                        {
+                            out[o] = acc_fct(out[o], p[kept.offset()]);
+                        }
+                    }
+                }
+            }
         }
-        else if (e.layout() == layout_type::column_major)
-        {
-            // we got column_major here
-            std::size_t last_ax = merge_loops(axes.begin(), axes.end());
+    }
 
-            // erasing the front vs the back
-            iter_shape.erase(iter_shape.begin(), iter_shape.begin() + ptrdiff_t(last_ax + 1));
-            iter_strides.erase(iter_strides.begin(), iter_strides.begin() + ptrdiff_t(last_ax + 1));
+    /********************
+     * reduce_immediate *
+     ********************/
 
-            // and reversing, to make it work with the same next_idx function
-            std::reverse(iter_shape.begin(), iter_shape.end());
-            std::reverse(iter_strides.begin(), iter_strides.end());
+    namespace detail
+    {
+        /**
+         * Shape of the reduction of \c e over \c axes. The reduced axes
+         * are kept with a size of 1 when \c keep_dims is true.
+         */
+        template <class E, class X>
+        inline dynamic_shape<std::size_t> make_reduced_shape(const E& e, const X& axes, bool keep_dims)
+        {
+            dynamic_shape<std::size_t> res;
+            for (std::size_t i = 0; i < e.dimension(); ++i)
+            {
+                if (std::find(axes.cbegin(), axes.cend(), i) == axes.cend())
+                {
+                    res.push_back(e.shape()[i]);
+                }
+                else if (keep_dims)
+                {
+                    res.push_back(1);
+                }
+            }
+            return res;
         }
-        else
+
+        /**
+         * Returns the layout in which the elements of the strided expression
+         * \c e are contiguous in memory, or layout_type::dynamic if they are not.
+         */
+        template <class E>
+        inline layout_type contiguous_data_layout(const E& e)
         {
-            throw std::runtime_error("Layout not supported in immediate reduction.");
+            if (E::contiguous_layout)
+            {
+                return e.layout();
+            }
+            dynamic_shape<std::size_t> strides(e.dimension());
+            for (layout_type l : {layout_type::row_major, layout_type::column_major})
+            {
+                compute_strides(e.shape(), l, strides);
+                if (std::equal(strides.cbegin(), strides.cend(), e.strides().cbegin()))
+                {
+                    return l;
+                }
+            }
+            return layout_type::dynamic;
         }
 
-        xindex temp_idx(iter_shape.size());
-        auto next_idx = [&iter_shape, &iter_strides, &temp_idx]()
+        /**
+         * Reduces the contiguous elements of \c e, starting at \c data and
+         * stored with the given layout, into \c result. \c result must have
+         * the same layout.
+         */
+        template <class F, class E, class X, class R, class T>
+        inline void reduce_contiguous_data(const F& f, const E& e, const X& axes, R& result,
+                                           const T* data, layout_type layout)
         {
-            std::size_t i = iter_shape.size();
-            for (; i > 0; --i)
+            using shape_type = dynamic_shape<std::size_t>;
+            using accumulate_functor = std::decay_t<decltype(std::get<0>(f))>;
+            using result_type = typename accumulate_functor::result_type;
+
+            // retrieve functors from triple struct
+            auto acc_fct = std::get<0>(f);
+            auto init_fct = std::get<1>(f);
+            auto merge_fct = std::get<2>(f);
+
+            // Built-in functors reduce contiguous data with simd kernels
+            using value_type = std::decay_t<T>;
+            using init_functor = std::decay_t<decltype(init_fct)>;
+            using use_simd = std::integral_constant<bool, std::is_same<init_functor, xtl::identity>::value &&
+                                                          use_simd_reduce<accumulate_functor, result_type, value_type>::value>;
+
+            shape_type iter_shape = e.shape();
+            shape_type iter_strides(e.dimension());
+            bool keep_dims = result.dimension() == e.dimension();
+
+            // Fast track for complete reduction
+            if (e.dimension() == axes.size())
+            {
+                auto begin = data;
+                result_type tmp = init_fct(*begin);
+                *result.raw_data() = reduce_contiguous(acc_fct, tmp, begin + 1, e.size() - 1, use_simd());
+                return;
+            }
+
+            std::size_t ax_idx = (layout == layout_type::row_major) ? axes.size() - 1 : 0;
+            std::size_t inner_loop_size = e.strides()[axes[ax_idx]];
+            std::size_t inner_stride    = e.strides()[axes[ax_idx]];
+            std::size_t outer_loop_size = e.shape()[axes[ax_idx]];
+
+            // The following code merges reduction axes "at the end" (or the beginning for col_major)
+            // together by increasing the size of the outer loop where appropriate
+            auto merge_loops = [&outer_loop_size, &e](auto it, auto end)
             {
-                if (ptrdiff_t(temp_idx[i - 1]) >= ptrdiff_t(iter_shape[i - 1]) - 1)
+                auto last_ax = *it;
+                ++it;
+                for (; it != end; ++it)
                 {
-                    temp_idx[i - 1] = 0;
+                    // note that we check is_sorted, so this condition is valid
+                    if (std::abs(ptrdiff_t(*it) - ptrdiff_t(last_ax)) ==  1)
+                    {
+                        last_ax = *it;
+                        outer_loop_size *= e.shape()[last_ax];
+                    }
                 }
-                else
+                return last_ax;
+            };
+
+            for (std::size_t i = 0, idx = 0; i < e.dimension(); ++i)
+            {
+                if (std::find(axes.begin(), axes.end(), i) == axes.end())
                 {
-                    temp_idx[i - 1]++;
-                    break;
+                    // i not in axes!
+                    iter_strides[i] = result.strides()[keep_dims ? i : idx];
+                    ++idx;
                 }
             }
-            return std::make_pair(i == 0,
-                                  std::inner_product(temp_idx.begin(), temp_idx.end(),
-                                                     iter_strides.begin(), ptrdiff_t(0)));
-        };
 
-        auto begin = e.raw_data();
-        auto out = result.raw_data();
-        auto out_begin = result.raw_data();
-
-        ptrdiff_t next_stride = 0;
+            if (layout == layout_type::row_major)
+            {
+                std::size_t last_ax = merge_loops(axes.rbegin(), axes.rend());
 
-        std::pair<bool, ptrdiff_t> idx_res(false, 0);
+                iter_shape.erase(iter_shape.begin() + ptrdiff_t(last_ax), iter_shape.end());
+                iter_strides.erase(iter_strides.begin() + ptrdiff_t(last_ax), iter_strides.end());
+            }
+            else if (layout == layout_type::column_major)
+            {
+                // we got column_major here
+                std::size_t last_ax = merge_loops(axes.begin(), axes.end());
 
-        // Remark: eventually some modifications here to make conditions faster where merge + accumulate is the
-        // same function (e.g. check std::is_same<decltype(merge_fct), decltype(acc_fct)>::value) ...
+                // erasing the front vs the back
+                iter_shape.erase(iter_shape.begin(), iter_shape.begin() + ptrdiff_t(last_ax + 1));
+                iter_strides.erase(iter_strides.begin(), iter_strides.begin() + ptrdiff_t(last_ax + 1));
 
-        auto merge_border = out;
-        bool merge = false;
+                // and reversing, to make it work with the same next_idx function
+                std::reverse(iter_shape.begin(), iter_shape.end());
+                std::reverse(iter_strides.begin(), iter_strides.end());
+            }
+            else
+            {
+                throw std::runtime_error("Layout not supported in immediate reduction.");
+            }
 
-        // TODO there could be some performance gain by removing merge checking
-        //      when axes.size() == 1 and even next_idx could be removed for something simpler (next_stride always the same)
-        //      best way to do this would be to create a function that takes (begin, out, outer_loop_size, inner_loop_size, next_idx_lambda)
-        // Decide if going about it row-wise or col-wise
-        if (inner_stride == 1)
-        {
-            while(idx_res.first != true)
+            xindex temp_idx(iter_shape.size());
+            auto next_idx = [&iter_shape, &iter_strides, &temp_idx]()
             {
-                // for unknown reasons it's much faster to use a temporary variable and
-                // std::accumulate here -- probably some cache behavior
-                result_type tmp;
-                tmp = init_fct(*begin);
-                tmp = std::accumulate(begin + 1, begin + outer_loop_size, tmp, acc_fct);
+                std::size_t i = iter_shape.size();
+                for (; i > 0; --i)
+                {
+                    if (ptrdiff_t(temp_idx[i - 1]) >= ptrdiff_t(iter_shape[i - 1]) - 1)
+                    {
+                        temp_idx[i - 1] = 0;
+                    }
+                    else
+                    {
+                        temp_idx[i - 1]++;
+                        break;
+                    }
+                }
+                return std::make_pair(i == 0,
+                                      std::inner_product(temp_idx.begin(), temp_idx.end(),
+                                                         iter_strides.begin(), ptrdiff_t(0)));
+            };
+
+            auto begin = data;
+            auto out = result.raw_data();
+            auto out_begin = result.raw_data();
 
-                // use merge function if necessary
-                *out = merge ? merge_fct(*out, tmp) : tmp;
+            ptrdiff_t next_stride = 0;
 
-                begin += outer_loop_size;
+            std::pair<bool, ptrdiff_t> idx_res(false, 0);
 
-                idx_res = next_idx();
-                next_stride = idx_res.second;
-                out = out_begin + next_stride;
+            // Remark: eventually some modifications here to make conditions faster where merge + accumulate is the
+            // same function (e.g. check std::is_same<decltype(merge_fct), decltype(acc_fct)>::value) ...
 
-                if (out > merge_border)
+            auto merge_border = out;
+            bool merge = false;
+
+            // TODO there could be some performance gain by removing merge checking
+            //      when axes.size() == 1 and even next_idx could be removed for something simpler (next_stride always the same)
+            //      best way to do this would be to create a function that takes (begin, out, outer_loop_size, inner_loop_size, next_idx_lambda)
+            // Decide if going about it row-wise or col-wise
+            if (inner_stride == 1)
+            {
+                while(idx_res.first != true)
                 {
-                    // looped over once
-                    merge = false;
-                    merge_border = out;
-                }
-                else
+                    // for unknown reasons it's much faster to use a temporary variable and
+                    // std::accumulate here -- probably some cache behavior
+                    result_type tmp;
+                    tmp = init_fct(*begin);
+                    tmp = reduce_contiguous(acc_fct, tmp, begin + 1, outer_loop_size - 1, use_simd());
+
+                    // use merge function if necessary
+                    *out = merge ? merge_fct(*out, tmp) : tmp;
+
+                    begin += outer_loop_size;
+
+                    idx_res = next_idx();
+                    next_stride = idx_res.second;
+                    out = out_begin + next_stride;
+
+                    if (out > merge_border)
+                    {
+                        // looped over once
+                        merge = false;
+                        merge_border = out;
+                    }
+                    else
+                    {
+                        merge = true;
+                    }
+                };
+            }
+            else
+            {
+                while(idx_res.first != true)
                 {
-                    merge = true;
-                }
-            };
+                    std::transform(out, out + inner_loop_size, begin, out,
+                                   [merge, &init_fct, &acc_fct](auto&& v1, auto&& v2)
+                                   {
+                                        return merge ? acc_fct(v1, v2) : result_type(init_fct(v2));
+                                   }
+                    );
+
+                    begin += inner_stride;
+                    for (std::size_t i = 1; i < outer_loop_size; ++i)
+                    {
+                        transform_contiguous(acc_fct, out, begin, inner_loop_size, use_simd());
+                        begin += inner_stride;
+                    }
+
+                    idx_res = next_idx();
+                    next_stride = idx_res.second;
+                    out = out_begin + next_stride;
+
+                    if (out > merge_border)
+                    {
+                        // looped over once
+                        merge = false;
+                        merge_border = out;
+                    }
+                    else
+                    {
+                        merge = true;
+                    }
+
+                };
+            }
         }
-        else
+
+        /**
+         * Reduces the strided expression \c e over \c axes into \c result,
+         * which must have the shape of the reduction and a row-major or
+         * column-major layout. Reduced axes may be kept in \c result with
+         * a size of 1. The elements of \c e are read in place: when they
+         * are not contiguous in the layout of \c result, they are traversed
+         * with their strides from the data offset of \c e.
+         */
+        template <class F, class E, class X, class R>
+        inline void reduce_immediate_impl(const F& f, const E& e, const X& axes, R& result)
         {
-            while(idx_res.first != true)
+            if (!std::is_sorted(axes.cbegin(), axes.cend()))
             {
-                std::transform(out, out + inner_loop_size, begin, out,
-                               [merge, &init_fct, &merge_fct](auto&& v1, auto&& v2)
-                               {
-                                    return merge ? merge_fct(v1, v2) : init_fct(v2);
-                               }
-                );
+                throw std::runtime_error("Reducing axes should be sorted");
+            }
 
-                begin += inner_stride;
-                for (std::size_t i = 1; i < outer_loop_size; ++i)
-                {
-                    std::transform(out, out + inner_loop_size, begin, out, acc_fct);
-                    begin += inner_stride;
-                }
+            const auto* data = e.raw_data() + e.raw_data_offset();
+            layout_type layout = contiguous_data_layout(e);
+            if (layout != layout_type::dynamic && layout == result.layout())
+            {
+                reduce_contiguous_data(f, e, axes, result, data, layout);
+                return;
+            }
 
-                idx_res = next_idx();
-                next_stride = idx_res.second;
-                out = out_begin + next_stride;
+            xreduction_spaces spaces = make_reduction_spaces(e, axes);
+            if (spaces.reduced_size == 0 || spaces.kept_size == 0)
+            {
+                return;
+            }
+            if (result.layout() == layout_type::column_major)
+            {
+                // The first kept dimension varies fastest in the result
+                std::reverse(spaces.kept_shape.begin(), spaces.kept_shape.end());
+                std::reverse(spaces.kept_strides.begin(), spaces.kept_strides.end());
+            }
+            reduce_block(f, data, result.raw_data(), spaces, 0, spaces.kept_size, 0, spaces.reduced_size);
+        }
 
-                if (out > merge_border)
+        template <class E>
+        inline layout_type reduce_immediate_layout(const E& e)
+        {
+            layout_type l = E::static_layout;
+            if (l != layout_type::row_major && l != layout_type::column_major)
+            {
+                l = contiguous_data_layout(e);
+            }
+            return l == layout_type::dynamic ? DEFAULT_LAYOUT : l;
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_immediate(F&& f, E&& e, X&& axes, std::true_type)
+        {
+            using accumulate_functor = std::decay_t<decltype(std::get<0>(f))>;
+            using result_type = typename accumulate_functor::result_type;
+
+            xt::xarray<result_type, std::decay_t<E>::static_layout> result;
+            result.resize(make_reduced_shape(e, axes, false), reduce_immediate_layout(e));
+            reduce_immediate_impl(f, e, axes, result);
+            return result;
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_immediate(F&& f, E&& e, X&& axes, std::false_type)
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+            xt::xarray<value_type> tmp = std::forward<E>(e);
+            return reduce_immediate(std::forward<F>(f), tmp, std::forward<X>(axes), std::true_type());
+        }
+    }
+
+    /**
+     * Reduces \c e over \c axes and returns the result in a container.
+     * Strided expressions (containers, views and adaptors) are reduced in
+     * place from their data offset and strides, contiguous data with the
+     * simd kernels of the built-in functors. Other expressions are
+     * evaluated first.
+     */
+    template <class F, class E, class X>
+    auto reduce_immediate(F&& f, E&& e, X&& axes)
+    {
+        return detail::reduce_immediate(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes),
+                                        detail::has_memory_span<std::decay_t<E>>());
+    }
+
+    /*******************
+     * reduce_parallel *
+     *******************/
+
+    namespace detail
+    {
+        /**
+         * Reduces the strided data described by \c spaces and stores the
+         * results in \c out, in the row-major order of the kept dimensions.
+         */
+        template <class F, class T, class R>
+        inline void reduce_parallel_data(const F& f, const T* data, const xreduction_spaces& spaces, R* out)
+        {
+            using result_type = R;
+            using size_type = std::size_t;
+
+            if (spaces.reduced_size == 0 || spaces.kept_size == 0)
+            {
+                return;
+            }
+
+            size_type n_threads = get_num_threads();
+            size_type grain = XTENSOR_PARALLEL_GRAIN_SIZE;
+
+            if (spaces.kept_size >= n_threads)
+            {
+                // Enough outputs: each thread computes a range of them
+                size_type out_grain = std::max(grain / spaces.reduced_size, size_type(1));
+                parallel_for(0, spaces.kept_size, out_grain, [&](size_type first, size_type last) {
+                    reduce_block(f, data, out + first, spaces, first, last, 0, spaces.reduced_size);
+                });
+                return;
+            }
+
+            // Few outputs: the reduced range is split between threads, the
+            // partial results are then combined with the merge functor.
+            size_type n_chunks = std::max(std::min(n_threads, spaces.reduced_size * spaces.kept_size / grain), size_type(1));
+            n_chunks = std::min(n_chunks, spaces.reduced_size);
+            std::vector<result_type> partials(n_chunks * spaces.kept_size);
+            parallel_for(0, n_chunks, 1, [&](size_type first, size_type last) {
+                for (size_type c = first; c < last; ++c)
                 {
-                    // looped over once
-                    merge = false;
-                    merge_border = out;
+                    size_type r_first = c * spaces.reduced_size / n_chunks;
+                    size_type r_last = (c + 1) * spaces.reduced_size / n_chunks;
+                    reduce_block(f, data, partials.data() + c * spaces.kept_size, spaces,
+                                 0, spaces.kept_size, r_first, r_last);
                 }
-                else
+            });
+
+            const auto& merge_fct = std::get<2>(f);
+            for (size_type step = 1; step < n_chunks; step *= 2)
+            {
+                for (size_type c = 0; c + step < n_chunks; c += 2 * step)
                 {
-                    merge = true;
+                    result_type* lhs = partials.data() + c * spaces.kept_size;
+                    const result_type* rhs = partials.data() + (c + step) * spaces.kept_size;
+                    for (size_type o = 0; o < spaces.kept_size; ++o)
+                    {
+                        lhs[o] = merge_fct(lhs[o], rhs[o]);
+                    }
                 }
+            }
+            std::copy(partials.cbegin(), partials.cbegin() + std::ptrdiff_t(spaces.kept_size), out);
+        }
 
-            };
+        template <class F, class E, class X>
+        inline auto reduce_parallel_impl(F&& f, E&& e, X&& axes, std::true_type)
+        {
+            using accumulate_functor = std::decay_t<decltype(std::get<0>(f))>;
+            using result_type = typename accumulate_functor::result_type;
+
+            if (!std::is_sorted(axes.cbegin(), axes.cend()))
+            {
+                throw std::runtime_error("Reducing axes should be sorted");
+            }
+
+            xreduction_spaces spaces = make_reduction_spaces(e, axes);
+            xt::xarray<result_type> result(spaces.kept_shape);
+            reduce_parallel_data(f, e.raw_data() + e.raw_data_offset(), spaces, result.raw_data());
+            return result;
         }
-        return result;
+
+        template <class F, class E, class X>
+        inline auto reduce_parallel_impl(F&& f, E&& e, X&& axes, std::false_type)
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+            xt::xarray<value_type> tmp = std::forward<E>(e);
+            return reduce_parallel_impl(std::forward<F>(f), tmp, std::forward<X>(axes), std::true_type());
+        }
+    }
+
+    /**
+     * Reduces \c e over \c axes with several threads. When the result has
+     * enough elements, its elements are split between the threads. Otherwise,
+     * each thread reduces a part of the reduced axes and the partial results
+     * are combined with the merge functor of \c f in a tree. Expressions
+     * without a raw data interface are evaluated first.
+     */
+    template <class F, class E, class X>
+    inline auto reduce_parallel(F&& f, E&& e, X&& axes)
+    {
+        return detail::reduce_parallel_impl(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes),
+                                            detail::has_memory_span<std::decay_t<E>>());
     }
 
     /*************
      * xreducer  *
      *************/
 
-    template <class ST, class X>
+    template <class ST, class X, bool KD = false>
     struct xreducer_shape_type;
 
     template <class REDUCE_FUNC, class INIT_FUNC = xtl::identity, class MERGE_FUNC = REDUCE_FUNC>
@@ -331,18 +942,18 @@ namespace xt
         return reducer_type(std::forward<RF>(reduce_func), std::forward<IF>(init_func), std::forward<MF>(merge_func));
     }
 
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD = false>
     class xreducer;
 
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD = false>
     class xreducer_stepper;
 
-    template <class F, class CT, class X>
-    struct xiterable_inner_types<xreducer<F, CT, X>>
+    template <class F, class CT, class X, bool KD>
+    struct xiterable_inner_types<xreducer<F, CT, X, KD>>
     {
         using xexpression_type = std::decay_t<CT>;
-        using inner_shape_type = typename xreducer_shape_type<typename xexpression_type::shape_type, std::decay_t<X>>::type;
-        using const_stepper = xreducer_stepper<F, CT, X>;
+        using inner_shape_type = typename xreducer_shape_type<typename xexpression_type::shape_type, std::decay_t<X>, KD>::type;
+        using const_stepper = xreducer_stepper<F, CT, X, KD>;
         using stepper = const_stepper;
     };
 
@@ -357,19 +968,20 @@ namespace xt
      * @tparam F a tuple of functors (class \ref xreducer_functors or compatible)
      * @tparam CT the closure type of the \ref xexpression to reduce
      * @tparam X the list of axes
+     * @tparam KD whether the reduced axes are kept with a size of 1
      *
      * The reducer's result_type is deduced from the result type of function
      * <tt>F::reduce_functor_type</tt> when called with elements of the expression @tparam CT.
      *
      * @sa reduce
      */
-    template <class F, class CT, class X>
-    class xreducer : public xexpression<xreducer<F, CT, X>>,
-                     public xconst_iterable<xreducer<F, CT, X>>
+    template <class F, class CT, class X, bool KD>
+    class xreducer : public xexpression<xreducer<F, CT, X, KD>>,
+                     public xconst_iterable<xreducer<F, CT, X, KD>>
     {
     public:
 
-        using self_type = xreducer<F, CT, X>;
+        using self_type = xreducer<F, CT, X, KD>;
         using reduce_functor_type = typename std::decay_t<F>::reduce_functor_type;
         using init_functor_type = typename std::decay_t<F>::init_functor_type;
         using merge_functor_type = typename std::decay_t<F>::merge_functor_type;
@@ -439,7 +1051,7 @@ namespace xt
         inner_shape_type m_shape;
         shape_type m_dim_mapping;
 
-        friend class xreducer_stepper<F, CT, X>;
+        friend class xreducer_stepper<F, CT, X, KD>;
     };
 
     /*************************
@@ -460,6 +1072,174 @@ namespace xt
         {
             return reduce_immediate(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes));
         }
+
+        template <class F, class E, class X>
+        inline auto reduce_impl(F&& f, E&& e, X&& axes, evaluation_strategy::parallel) noexcept
+        {
+            return reduce_parallel(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes));
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_impl(F&& f, E&& e, X&& axes, evaluation_strategy::keep_dims<evaluation_strategy::lazy>) noexcept
+        {
+            using reducer_type = xreducer<F, const_xclosure_t<E>, xtl::const_closure_type_t<X>, true>;
+            return reducer_type(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes));
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_impl(F&& f, E&& e, X&& axes, evaluation_strategy::keep_dims<evaluation_strategy::immediate>) noexcept
+        {
+            auto shape = make_reduced_shape(e, axes, true);
+            auto res = reduce_immediate(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes));
+            res.reshape(std::move(shape), res.layout());
+            return res;
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_impl(F&& f, E&& e, X&& axes, evaluation_strategy::keep_dims<evaluation_strategy::parallel>) noexcept
+        {
+            auto shape = make_reduced_shape(e, axes, true);
+            auto res = reduce_parallel(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes));
+            res.reshape(std::move(shape), res.layout());
+            return res;
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_impl(F&& f, E&& e, X&& axes, evaluation_strategy::cached) noexcept
+        {
+            return cached(reduce_impl(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), evaluation_strategy::lazy()));
+        }
+
+        template <class F, class E, class X>
+        inline auto reduce_impl(F&& f, E&& e, X&& axes, evaluation_strategy::keep_dims<evaluation_strategy::cached>) noexcept
+        {
+            return cached(reduce_impl(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes),
+                                      evaluation_strategy::keep_dims<evaluation_strategy::lazy>()));
+        }
+
+        template <class ES>
+        struct is_keep_dims : std::false_type
+        {
+        };
+
+        template <class ES>
+        struct is_keep_dims<evaluation_strategy::keep_dims<ES>> : std::true_type
+        {
+        };
+
+        template <class R, class S>
+        inline void check_reduction_output(const R& out, const S& shape)
+        {
+            if (is_array<typename R::shape_type>::value && out.dimension() != shape.size())
+            {
+                throw std::runtime_error("Reduction output has the wrong number of dimensions");
+            }
+        }
+
+        // Evaluates the reduction with the given strategy and assigns it to
+        // out, which is only reallocated if its shape differs.
+        template <class F, class E, class X, class R, class ES>
+        inline void reduce_assign(F&& f, E&& e, X&& axes, R& out, ES es)
+        {
+            auto res = reduce_impl(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), es);
+            check_reduction_output(out, res.shape());
+            assign_xexpression(out, res);
+        }
+
+        template <class F, class E, class X, class R, class ES>
+        inline void reduce_immediate_into(F&& f, E&& e, X&& axes, R& out, ES, std::true_type)
+        {
+            auto shape = make_reduced_shape(e, axes, is_keep_dims<ES>::value);
+            check_reduction_output(out, shape);
+            out.resize(std::move(shape));
+            reduce_immediate_impl(f, e, axes, out);
+        }
+
+        template <class F, class E, class X, class R, class ES>
+        inline void reduce_immediate_into(F&& f, E&& e, X&& axes, R& out, ES es, std::false_type)
+        {
+            reduce_assign(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es);
+        }
+
+        template <class F, class E, class X, class R, class ES>
+        inline void reduce_parallel_into(F&& f, E&& e, X&& axes, R& out, ES es, std::true_type)
+        {
+            if (!std::is_sorted(axes.cbegin(), axes.cend()))
+            {
+                throw std::runtime_error("Reducing axes should be sorted");
+            }
+            auto shape = make_reduced_shape(e, axes, is_keep_dims<ES>::value);
+            check_reduction_output(out, shape);
+            out.resize(std::move(shape));
+            if (out.layout() == layout_type::row_major)
+            {
+                reduce_parallel_data(f, e.raw_data() + e.raw_data_offset(), make_reduction_spaces(e, axes), out.raw_data());
+            }
+            else
+            {
+                reduce_assign(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es);
+            }
+        }
+
+        template <class F, class E, class X, class R, class ES>
+        inline void reduce_parallel_into(F&& f, E&& e, X&& axes, R& out, ES es, std::false_type)
+        {
+            reduce_assign(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es);
+        }
+
+        // The immediate and parallel strategies write directly into out
+        // when it holds the result type of the reduction and e is strided
+        template <class F, class R>
+        using reduces_into = std::is_same<typename R::value_type,
+                                          typename std::decay_t<decltype(std::get<0>(std::declval<F>()))>::result_type>;
+
+        template <class F, class E, class X, class R, class ES>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, ES es)
+        {
+            reduce_assign(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es);
+        }
+
+        template <class F, class E, class X, class R>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, evaluation_strategy::immediate es)
+        {
+            using direct = std::integral_constant<bool, reduces_into<F, R>::value && has_memory_span<std::decay_t<E>>::value>;
+            reduce_immediate_into(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es, direct());
+        }
+
+        template <class F, class E, class X, class R>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, evaluation_strategy::keep_dims<evaluation_strategy::immediate> es)
+        {
+            using direct = std::integral_constant<bool, reduces_into<F, R>::value && has_memory_span<std::decay_t<E>>::value>;
+            reduce_immediate_into(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es, direct());
+        }
+
+        template <class F, class E, class X, class R>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, evaluation_strategy::parallel es)
+        {
+            using direct = std::integral_constant<bool, reduces_into<F, R>::value && has_memory_span<std::decay_t<E>>::value>;
+            reduce_parallel_into(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es, direct());
+        }
+
+        template <class F, class E, class X, class R>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, evaluation_strategy::keep_dims<evaluation_strategy::parallel> es)
+        {
+            using direct = std::integral_constant<bool, reduces_into<F, R>::value && has_memory_span<std::decay_t<E>>::value>;
+            reduce_parallel_into(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, es, direct());
+        }
+
+        // Nothing reuses the cache of a reduction evaluated into out
+        template <class F, class E, class X, class R>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, evaluation_strategy::cached)
+        {
+            reduce_assign(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, evaluation_strategy::lazy());
+        }
+
+        template <class F, class E, class X, class R>
+        inline void reduce_into(F&& f, E&& e, X&& axes, R& out, evaluation_strategy::keep_dims<evaluation_strategy::cached>)
+        {
+            reduce_assign(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out,
+                          evaluation_strategy::keep_dims<evaluation_strategy::lazy>());
+        }
     }
 
     /**
@@ -469,7 +1249,8 @@ namespace xt
      * @param f the reducing function to apply.
      * @param e the \ref xexpression to reduce.
      * @param axes the list of axes.
-     * @param evaluation_strategy evaluation strategy to use (lazy (default), or immediate)
+     * @param evaluation_strategy evaluation strategy to use (lazy (default), immediate, parallel or cached),
+     * wrapped in evaluation_strategy::keep_dims to keep the reduced axes with a size of 1
      *
      * The returned expression either hold a const reference to \p e or a copy
      * depending on whether \p e is an lvalue or an rvalue.
@@ -488,6 +1269,30 @@ namespace xt
         return detail::reduce_impl(std::forward<F>(f), std::forward<E>(e), std::move(ar), evaluation_strategy);
     }
 
+    /**
+     * @brief Applies the specified reducing function to an expression over
+     * the given axes and stores the result in a container.
+     *
+     * \p out is only reallocated when its shape differs from the shape of
+     * the reduction, so that it can be reused across reductions. The
+     * immediate and parallel strategies write directly into \p out when
+     * its value type is the result type of the reduction.
+     *
+     * @param f the reducing function to apply.
+     * @param e the \ref xexpression to reduce.
+     * @param axes the list of axes.
+     * @param out the container receiving the result.
+     * @param evaluation_strategy evaluation strategy to use (lazy (default), immediate, parallel or cached),
+     * wrapped in evaluation_strategy::keep_dims to keep the reduced axes with a size of 1
+     * @return a reference to \p out
+     */
+    template <class F, class E, class X, class R, class ES, class>
+    inline R& reduce(F&& f, E&& e, X&& axes, R& out, ES evaluation_strategy)
+    {
+        detail::reduce_into(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes), out, evaluation_strategy);
+        return out;
+    }
+
 #ifdef X_OLD_CLANG
     template <class F, class E, class I>
     inline auto reduce(F&& f, E&& e, std::initializer_list<I> axes) noexcept
@@ -496,27 +1301,44 @@ namespace xt
         using reducer_type = xreducer<F, const_xclosure_t<E>, axes_type>;
         return reducer_type(std::forward<F>(f), std::forward<E>(e), xtl::forward_sequence<axes_type>(axes));
     }
+
+    template <class F, class E, class I, class R>
+    inline R& reduce(F&& f, E&& e, std::initializer_list<I> axes, R& out)
+    {
+        using axes_type = std::vector<typename std::decay_t<E>::size_type>;
+        detail::reduce_into(std::forward<F>(f), std::forward<E>(e), xtl::forward_sequence<axes_type>(axes), out,
+                            evaluation_strategy::lazy());
+        return out;
+    }
 #else
-    template <class F, class E, class I, std::size_t N, class ES>
+    template <class F, class E, class I, std::size_t N, class ES, class>
     inline auto reduce(F&& f, E&& e, const I (&axes)[N], ES evaluation_strategy) noexcept
     {
         using axes_type = std::array<typename std::decay_t<E>::size_type, N>;
         return detail::reduce_impl(std::forward<F>(f), std::forward<E>(e), xtl::forward_sequence<axes_type>(axes), evaluation_strategy);
 
     }
+
+    template <class F, class E, class I, std::size_t N, class R, class ES, class>
+    inline R& reduce(F&& f, E&& e, const I (&axes)[N], R& out, ES evaluation_strategy)
+    {
+        using axes_type = std::array<typename std::decay_t<E>::size_type, N>;
+        detail::reduce_into(std::forward<F>(f), std::forward<E>(e), xtl::forward_sequence<axes_type>(axes), out, evaluation_strategy);
+        return out;
+    }
 #endif
 
     /********************
      * xreducer_stepper *
      ********************/
 
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     class xreducer_stepper
     {
     public:
 
-        using self_type = xreducer_stepper<F, CT, X>;
-        using xreducer_type = xreducer<F, CT, X>;
+        using self_type = xreducer_stepper<F, CT, X, KD>;
+        using xreducer_type = xreducer<F, CT, X, KD>;
 
         using value_type = typename xreducer_type::value_type;
         using reference = typename xreducer_type::value_type;
@@ -548,6 +1370,7 @@ namespace xt
         reference aggregate(size_type dim) const;
 
         substepper_type get_substepper_begin() const;
+        bool is_substepper_dim(size_type dim) const noexcept;
         size_type get_dim(size_type dim) const noexcept;
         size_type shape(size_type i) const noexcept;
         size_type axis(size_type i) const noexcept;
@@ -557,31 +1380,37 @@ namespace xt
         mutable substepper_type m_stepper;
     };
 
-    template <class F, class CT, class X>
-    bool operator==(const xreducer_stepper<F, CT, X>& lhs,
-                    const xreducer_stepper<F, CT, X>& rhs);
+    template <class F, class CT, class X, bool KD>
+    bool operator==(const xreducer_stepper<F, CT, X, KD>& lhs,
+                    const xreducer_stepper<F, CT, X, KD>& rhs);
 
-    template <class F, class CT, class X>
-    bool operator!=(const xreducer_stepper<F, CT, X>& lhs,
-                    const xreducer_stepper<F, CT, X>& rhs);
+    template <class F, class CT, class X, bool KD>
+    bool operator!=(const xreducer_stepper<F, CT, X, KD>& lhs,
+                    const xreducer_stepper<F, CT, X, KD>& rhs);
 
     /******************
      * xreducer utils *
      ******************/
 
     // meta-function returning the shape type for an xreducer
-    template <class ST, class X>
+    template <class ST, class X, bool KD>
     struct xreducer_shape_type
     {
         using type = promote_shape_t<ST, std::decay_t<X>>;
     };
 
     template <class I1, std::size_t N1, class I2, std::size_t N2>
-    struct xreducer_shape_type<std::array<I1, N1>, std::array<I2, N2>>
+    struct xreducer_shape_type<std::array<I1, N1>, std::array<I2, N2>, false>
     {
         using type = std::array<I2, N1 - N2>;
     };
 
+    template <class I1, std::size_t N1, class X>
+    struct xreducer_shape_type<std::array<I1, N1>, X, true>
+    {
+        using type = std::array<I1, N1>;
+    };
+
     namespace detail
     {
         template <class InputIt, class ExcludeIt, class OutputIt>
@@ -629,24 +1458,38 @@ namespace xt
      * @param e the expression to reduce
      * @param axes the axes along which the reduction is performed
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class Func, class CTA, class AX>
-    inline xreducer<F, CT, X>::xreducer(Func&& func, CTA&& e, AX&& axes)
+    inline xreducer<F, CT, X, KD>::xreducer(Func&& func, CTA&& e, AX&& axes)
         : m_e(std::forward<CTA>(e))
         , m_reduce(std::get<0>(func))
         , m_init(std::get<1>(func))
         , m_merge(std::get<2>(func))
         , m_axes(std::forward<AX>(axes))
-        , m_shape(xtl::make_sequence<inner_shape_type>(m_e.dimension() - m_axes.size(), 0))
-        , m_dim_mapping(xtl::make_sequence<shape_type>(m_e.dimension() - m_axes.size(), 0))
+        , m_shape(xtl::make_sequence<inner_shape_type>(KD ? m_e.dimension() : m_e.dimension() - m_axes.size(), 0))
+        , m_dim_mapping(xtl::make_sequence<shape_type>(KD ? m_e.dimension() : m_e.dimension() - m_axes.size(), 0))
     {
         if (!std::is_sorted(m_axes.cbegin(), m_axes.cend()))
         {
             throw std::runtime_error("Reducing axes should be sorted");
         }
-        detail::excluding_copy(m_e.shape().cbegin(), m_e.shape().cend(),
-                               m_axes.cbegin(), m_axes.cend(),
-                               m_shape.begin(), m_dim_mapping.begin());
+        if (KD)
+        {
+            // Reduced axes are mapped past the last dimension of the
+            // underlying expression, the stepper ignores them.
+            for (size_type i = 0; i < m_e.dimension(); ++i)
+            {
+                bool reduced = std::find(m_axes.cbegin(), m_axes.cend(), i) != m_axes.cend();
+                m_shape[i] = reduced ? 1 : m_e.shape()[i];
+                m_dim_mapping[i] = reduced ? m_e.dimension() : i;
+            }
+        }
+        else
+        {
+            detail::excluding_copy(m_e.shape().cbegin(), m_e.shape().cend(),
+                                   m_axes.cbegin(), m_axes.cend(),
+                                   m_shape.begin(), m_dim_mapping.begin());
+        }
     }
     //@}
 
@@ -656,8 +1499,8 @@ namespace xt
     /**
      * Returns the size of the expression.
      */
-    template <class F, class CT, class X>
-    inline auto xreducer<F, CT, X>::size() const noexcept -> size_type
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer<F, CT, X, KD>::size() const noexcept -> size_type
     {
         return compute_size(shape());
     }
@@ -665,8 +1508,8 @@ namespace xt
     /**
      * Returns the number of dimensions of the expression.
      */
-    template <class F, class CT, class X>
-    inline auto xreducer<F, CT, X>::dimension() const noexcept -> size_type
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer<F, CT, X, KD>::dimension() const noexcept -> size_type
     {
         return m_shape.size();
     }
@@ -674,8 +1517,8 @@ namespace xt
     /**
      * Returns the shape of the expression.
      */
-    template <class F, class CT, class X>
-    inline auto xreducer<F, CT, X>::shape() const noexcept -> const inner_shape_type&
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer<F, CT, X, KD>::shape() const noexcept -> const inner_shape_type&
     {
         return m_shape;
     }
@@ -683,8 +1526,8 @@ namespace xt
     /**
      * Returns the shape of the expression.
      */
-    template <class F, class CT, class X>
-    inline layout_type xreducer<F, CT, X>::layout() const noexcept
+    template <class F, class CT, class X, bool KD>
+    inline layout_type xreducer<F, CT, X, KD>::layout() const noexcept
     {
         return static_layout;
     }
@@ -699,9 +1542,9 @@ namespace xt
      * must be unsigned integers, the number of indices should be equal or greater than
      * the number of dimensions of the reducer.
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class... Args>
-    inline auto xreducer<F, CT, X>::operator()(Args... args) const -> const_reference
+    inline auto xreducer<F, CT, X, KD>::operator()(Args... args) const -> const_reference
     {
         std::array<std::size_t, sizeof...(Args)> arg_array = {{static_cast<std::size_t>(args)...}};
         return element(arg_array.cbegin(), arg_array.cend());
@@ -716,9 +1559,9 @@ namespace xt
      * @exception std::out_of_range if the number of argument is greater than the number of dimensions
      * or if indices are out of bounds.
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class... Args>
-    inline auto xreducer<F, CT, X>::at(Args... args) const -> const_reference
+    inline auto xreducer<F, CT, X, KD>::at(Args... args) const -> const_reference
     {
         check_access(shape(), static_cast<size_type>(args)...);
         return this->operator()(args...);
@@ -729,24 +1572,24 @@ namespace xt
      * must be unsigned integers, the number of indices in the sequence should be equal or greater
      * than the number of dimensions of the reducer.
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class S>
-    inline auto xreducer<F, CT, X>::operator[](const S& index) const
+    inline auto xreducer<F, CT, X, KD>::operator[](const S& index) const
         -> disable_integral_t<S, const_reference>
     {
         return element(index.cbegin(), index.cend());
     }
 
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class I>
-    inline auto xreducer<F, CT, X>::operator[](std::initializer_list<I> index) const
+    inline auto xreducer<F, CT, X, KD>::operator[](std::initializer_list<I> index) const
         -> const_reference
     {
         return element(index.begin(), index.end());
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer<F, CT, X>::operator[](size_type i) const -> const_reference
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer<F, CT, X, KD>::operator[](size_type i) const -> const_reference
     {
         return operator()(i);
     }
@@ -758,9 +1601,9 @@ namespace xt
      * The number of indices in the sequence should be equal to or greater
      * than the number of dimensions of the reducer.
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class It>
-    inline auto xreducer<F, CT, X>::element(It first, It last) const -> const_reference
+    inline auto xreducer<F, CT, X, KD>::element(It first, It last) const -> const_reference
     {
         auto stepper = const_stepper(*this, 0);
         size_type dim = 0;
@@ -781,9 +1624,9 @@ namespace xt
      * @param shape the result shape
      * @return a boolean indicating whether the broadcasting is trivial
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class S>
-    inline bool xreducer<F, CT, X>::broadcast_shape(S& shape, bool) const
+    inline bool xreducer<F, CT, X, KD>::broadcast_shape(S& shape, bool) const
     {
         return xt::broadcast_shape(m_shape, shape);
     }
@@ -793,25 +1636,25 @@ namespace xt
      * the broadcasting is trivial.
      * @return a boolean indicating whether the broadcasting is trivial
      */
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class S>
-    inline bool xreducer<F, CT, X>::is_trivial_broadcast(const S& /*strides*/) const noexcept
+    inline bool xreducer<F, CT, X, KD>::is_trivial_broadcast(const S& /*strides*/) const noexcept
     {
         return false;
     }
     //@}
 
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class S>
-    inline auto xreducer<F, CT, X>::stepper_begin(const S& shape) const noexcept -> const_stepper
+    inline auto xreducer<F, CT, X, KD>::stepper_begin(const S& shape) const noexcept -> const_stepper
     {
         size_type offset = shape.size() - dimension();
         return const_stepper(*this, offset);
     }
 
-    template <class F, class CT, class X>
+    template <class F, class CT, class X, bool KD>
     template <class S>
-    inline auto xreducer<F, CT, X>::stepper_end(const S& shape, layout_type l) const noexcept -> const_stepper
+    inline auto xreducer<F, CT, X, KD>::stepper_end(const S& shape, layout_type l) const noexcept -> const_stepper
     {
         size_type offset = shape.size() - dimension();
         return const_stepper(*this, offset, true, l);
@@ -821,8 +1664,8 @@ namespace xt
      * xreducer_stepper implementation *
      ***********************************/
 
-    template <class F, class CT, class X>
-    inline xreducer_stepper<F, CT, X>::xreducer_stepper(const xreducer_type& red, size_type offset, bool end, layout_type l)
+    template <class F, class CT, class X, bool KD>
+    inline xreducer_stepper<F, CT, X, KD>::xreducer_stepper(const xreducer_type& red, size_type offset, bool end, layout_type l)
         : m_reducer(red), m_offset(offset),
           m_stepper(get_substepper_begin())
     {
@@ -832,69 +1675,69 @@ namespace xt
         }
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer_stepper<F, CT, X>::operator*() const -> reference
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer_stepper<F, CT, X, KD>::operator*() const -> reference
     {
         reference r = aggregate(0);
         return r;
     }
 
-    template <class F, class CT, class X>
-    inline void xreducer_stepper<F, CT, X>::step(size_type dim, size_type n)
+    template <class F, class CT, class X, bool KD>
+    inline void xreducer_stepper<F, CT, X, KD>::step(size_type dim, size_type n)
     {
-        if (dim >= m_offset)
+        if (is_substepper_dim(dim))
         {
             m_stepper.step(get_dim(dim - m_offset), n);
         }
     }
 
-    template <class F, class CT, class X>
-    inline void xreducer_stepper<F, CT, X>::step_back(size_type dim, size_type n)
+    template <class F, class CT, class X, bool KD>
+    inline void xreducer_stepper<F, CT, X, KD>::step_back(size_type dim, size_type n)
     {
-        if (dim >= m_offset)
+        if (is_substepper_dim(dim))
         {
             m_stepper.step_back(get_dim(dim - m_offset), n);
         }
     }
 
-    template <class F, class CT, class X>
-    inline void xreducer_stepper<F, CT, X>::reset(size_type dim)
+    template <class F, class CT, class X, bool KD>
+    inline void xreducer_stepper<F, CT, X, KD>::reset(size_type dim)
     {
-        if (dim >= m_offset)
+        if (is_substepper_dim(dim))
         {
             m_stepper.reset(get_dim(dim - m_offset));
         }
     }
 
-    template <class F, class CT, class X>
-    inline void xreducer_stepper<F, CT, X>::reset_back(size_type dim)
+    template <class F, class CT, class X, bool KD>
+    inline void xreducer_stepper<F, CT, X, KD>::reset_back(size_type dim)
     {
-        if (dim >= m_offset)
+        if (is_substepper_dim(dim))
         {
             m_stepper.reset_back(get_dim(dim - m_offset));
         }
     }
 
-    template <class F, class CT, class X>
-    inline void xreducer_stepper<F, CT, X>::to_begin()
+    template <class F, class CT, class X, bool KD>
+    inline void xreducer_stepper<F, CT, X, KD>::to_begin()
     {
         m_stepper.to_begin();
     }
 
-    template <class F, class CT, class X>
-    inline void xreducer_stepper<F, CT, X>::to_end(layout_type l)
+    template <class F, class CT, class X, bool KD>
+    inline void xreducer_stepper<F, CT, X, KD>::to_end(layout_type l)
     {
         m_stepper.to_end(l);
     }
 
-    template <class F, class CT, class X>
-    inline bool xreducer_stepper<F, CT, X>::equal(const self_type& rhs) const
+    template <class F, class CT, class X, bool KD>
+    inline bool xreducer_stepper<F, CT, X, KD>::equal(const self_type& rhs) const
     {
         return &m_reducer == &(rhs.m_reducer) && m_stepper.equal(rhs.m_stepper);
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer_stepper<F, CT, X>::aggregate(size_type dim) const -> reference
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer_stepper<F, CT, X, KD>::aggregate(size_type dim) const -> reference
     {
         size_type index = axis(dim);
         size_type size = shape(index);
@@ -921,40 +1764,48 @@ namespace xt
         return res;
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer_stepper<F, CT, X>::get_substepper_begin() const -> substepper_type
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer_stepper<F, CT, X, KD>::get_substepper_begin() const -> substepper_type
     {
         return m_reducer.m_e.stepper_begin(m_reducer.m_e.shape());
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer_stepper<F, CT, X>::get_dim(size_type dim) const noexcept -> size_type
+    template <class F, class CT, class X, bool KD>
+    inline bool xreducer_stepper<F, CT, X, KD>::is_substepper_dim(size_type dim) const noexcept
+    {
+        // Broadcast dimensions and reduced axes kept in the shape of
+        // the reducer have no counterpart in the substepper
+        return dim >= m_offset && (!KD || get_dim(dim - m_offset) < m_reducer.m_e.dimension());
+    }
+
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer_stepper<F, CT, X, KD>::get_dim(size_type dim) const noexcept -> size_type
     {
         return m_reducer.m_dim_mapping[dim];
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer_stepper<F, CT, X>::shape(size_type i) const noexcept -> size_type
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer_stepper<F, CT, X, KD>::shape(size_type i) const noexcept -> size_type
     {
         return m_reducer.m_e.shape()[i];
     }
 
-    template <class F, class CT, class X>
-    inline auto xreducer_stepper<F, CT, X>::axis(size_type i) const noexcept -> size_type
+    template <class F, class CT, class X, bool KD>
+    inline auto xreducer_stepper<F, CT, X, KD>::axis(size_type i) const noexcept -> size_type
     {
         return m_reducer.m_axes[i];
     }
 
-    template <class F, class CT, class X>
-    inline bool operator==(const xreducer_stepper<F, CT, X>& lhs,
-                           const xreducer_stepper<F, CT, X>& rhs)
+    template <class F, class CT, class X, bool KD>
+    inline bool operator==(const xreducer_stepper<F, CT, X, KD>& lhs,
+                           const xreducer_stepper<F, CT, X, KD>& rhs)
     {
         return lhs.equal(rhs);
     }
 
-    template <class F, class CT, class X>
-    inline bool operator!=(const xreducer_stepper<F, CT, X>& lhs,
-                           const xreducer_stepper<F, CT, X>& rhs)
+    template <class F, class CT, class X, bool KD>
+    inline bool operator!=(const xreducer_stepper<F, CT, X, KD>& lhs,
+                           const xreducer_stepper<F, CT, X, KD>& rhs)
     {
         return !lhs.equal(rhs);
     }
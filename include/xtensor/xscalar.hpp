@@ -339,6 +339,11 @@ namespace xt
         void to_begin() noexcept;
         void to_end(layout_type l) noexcept;
 
+        template <class T>
+        T step_simd(size_type dim) noexcept;
+        bool has_linear_step(size_type dim) const noexcept;
+        bool is_equivalent_step(size_type dim1, size_type n1, size_type dim2, size_type n2) const noexcept;
+
         bool equal(const self_type& rhs) const noexcept;
 
     private:
@@ -973,7 +978,7 @@ namespace xt
     template <bool is_const, class CT>
     inline void xscalar_stepper<is_const, CT>::to_begin() noexcept
     {
-        p_c = p_c->stepper_begin(p_c->shap()).pc;
+        p_c = p_c->stepper_begin(p_c->shape()).p_c;
     }
 
     template <bool is_const, class CT>
@@ -982,6 +987,26 @@ namespace xt
         p_c = p_c->stepper_end(p_c->shape(), l).p_c;
     }
 
+    template <bool is_const, class CT>
+    template <class T>
+    inline T xscalar_stepper<is_const, CT>::step_simd(size_type /*dim*/) noexcept
+    {
+        return xsimd::set_simd<value_type, typename T::value_type>(p_c->operator()());
+    }
+
+    template <bool is_const, class CT>
+    inline bool xscalar_stepper<is_const, CT>::has_linear_step(size_type /*dim*/) const noexcept
+    {
+        return true;
+    }
+
+    template <bool is_const, class CT>
+    inline bool xscalar_stepper<is_const, CT>::is_equivalent_step(size_type /*dim1*/, size_type /*n1*/,
+                                                                  size_type /*dim2*/, size_type /*n2*/) const noexcept
+    {
+        return true;
+    }
+
     template <bool is_const, class CT>
     inline bool xscalar_stepper<is_const, CT>::equal(const self_type& rhs) const noexcept
     {
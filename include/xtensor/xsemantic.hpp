@@ -210,6 +210,43 @@ namespace xt
         derived_type& operator=(const xexpression<E>&);
     };
 
+    namespace detail
+    {
+        template <class D, class = void>
+        struct is_resizable : std::false_type
+        {
+        };
+
+        template <class D>
+        struct is_resizable<D, void_t<decltype(std::declval<D&>().resize(std::declval<typename D::shape_type>()))>>
+            : std::true_type
+        {
+        };
+
+        /**
+         * Assigns e to d if this does not require a temporary. Returns
+         * false and leaves d unchanged otherwise.
+         */
+        template <class D, class E>
+        inline bool assign_in_place(D& d, const xexpression<E>& e, bool resizable, std::true_type)
+        {
+            overlap_type overlap = memory_overlap(d, e.derived_cast());
+            bool in_place = (resizable && overlap == overlap_type::none) ||
+                (overlap != overlap_type::unsafe && has_same_broadcast_shape(d, e.derived_cast()));
+            if (in_place)
+            {
+                d.assign_xexpression(e);
+            }
+            return in_place;
+        }
+
+        template <class D, class E>
+        inline bool assign_in_place(D&, const xexpression<E>&, bool, std::false_type)
+        {
+            return false;
+        }
+    }
+
     /*********************************
      * xsemantic_base implementation *
      *********************************/
@@ -496,8 +533,19 @@ namespace xt
     template <class E>
     inline auto xsemantic_base<D>::operator=(const xexpression<E>& e) -> derived_type&
     {
-        temporary_type tmp(e);
-        return this->derived_cast().assign_temporary(std::move(tmp));
+        // The temporary is only required when e reads elements of *this
+        // that may already have been overwritten, or freed by a resize.
+        derived_type& d = this->derived_cast();
+        constexpr bool resizable = std::is_base_of<xcontainer_semantic<D>, D>::value;
+        using in_place = std::integral_constant<bool, detail::has_memory_span<D>::value &&
+                                                      (!resizable || detail::is_resizable<D>::value)>;
+        if (!detail::assign_in_place(d, e, resizable, in_place()))
+        {
+            temporary_type tmp(e);
+            detail::record_temporary(tmp.size() * sizeof(typename temporary_type::value_type));
+            d.assign_temporary(std::move(tmp));
+        }
+        return d;
     }
 
     /**************************************
@@ -10,33 +10,277 @@
 #define XTENSOR_SORT_HPP
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include "xarray.hpp"
 #include "xeval.hpp"
+#include "xparallel.hpp"
 #include "xstrided_view.hpp"
 #include "xslice.hpp"  // for xnone
 #include "xtensor.hpp"
+#include "xtensor_simd.hpp"
 
 namespace xt
 {
-    template <class E>
-    auto sort(const xexpression<E>& e, placeholders::xtuph /*t*/)
+    namespace detail
     {
-        using value_type = typename E::value_type;
-        const auto de = e.derived_cast();
+        template <class ES>
+        using is_parallel_strategy = std::is_same<ES, evaluation_strategy::parallel>;
+
+        /**
+         * Parallel merge sort: chunks of the range are sorted with std::sort
+         * on several threads, then merged pairwise until a single sorted
+         * run is left. Each merge round merges its pairs in parallel.
+         */
+        template <class It>
+        inline void parallel_sort(It first, It last)
+        {
+            std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            xchunks chunks = split_chunks(n);
+            if (chunks.count < 2)
+            {
+                std::sort(first, last);
+                return;
+            }
+
+            auto at = [first](std::size_t i) { return std::next(first, static_cast<std::ptrdiff_t>(i)); };
+            parallel_for_chunks(chunks, [&at](std::size_t, std::size_t begin, std::size_t end) {
+                std::sort(at(begin), at(end));
+            });
+
+            for (std::size_t width = chunks.length; width < n; width *= 2)
+            {
+                std::size_t n_pairs = (n + 2 * width - 1) / (2 * width);
+                parallel_for(0, n_pairs, 1, [&at, n, width](std::size_t begin, std::size_t end) {
+                    for (std::size_t p = begin; p != end; ++p)
+                    {
+                        std::size_t lo = 2 * p * width;
+                        std::size_t mid = std::min(n, lo + width);
+                        std::size_t hi = std::min(n, lo + 2 * width);
+                        std::inplace_merge(at(lo), at(mid), at(hi));
+                    }
+                });
+            }
+        }
+
+        /**
+         * Maps the values sortable by radix_sort to unsigned keys with the
+         * same order: the sign bit of signed integers is flipped, all the bits
+         * of negative floating point values and the sign bit of the positive
+         * ones are flipped.
+         */
+        template <class T, class = void>
+        struct radix_traits
+        {
+            static constexpr bool value = false;
+        };
+
+        template <class T>
+        struct radix_traits<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+        {
+            static constexpr bool value = true;
+            using key_type = std::make_unsigned_t<T>;
+
+            static key_type key(T v) noexcept
+            {
+                constexpr key_type sign = std::is_signed<T>::value ?
+                    static_cast<key_type>(key_type(1) << (8 * sizeof(T) - 1)) : key_type(0);
+                return static_cast<key_type>(static_cast<key_type>(v) ^ sign);
+            }
+        };
+
+        template <class T, class K>
+        struct radix_float_traits
+        {
+            static_assert(sizeof(T) == sizeof(K), "key type must have the size of the value type");
+            static constexpr bool value = true;
+            using key_type = K;
+
+            static key_type key(T v) noexcept
+            {
+                constexpr key_type sign = key_type(1) << (8 * sizeof(K) - 1);
+                key_type bits;
+                std::memcpy(&bits, &v, sizeof(T));
+                return (bits & sign) ? key_type(~bits) : key_type(bits | sign);
+            }
+        };
+
+        template <>
+        struct radix_traits<float> : radix_float_traits<float, std::uint32_t>
+        {
+        };
+
+        template <>
+        struct radix_traits<double> : radix_float_traits<double, std::uint64_t>
+        {
+        };
+
+        /**
+         * LSD radix sort of a non empty contiguous range, one byte of the keys
+         * per pass. Passes where all the elements have the same byte are
+         * skipped. If parallel is true, the range is split in consecutive
+         * chunks whose histograms are computed and whose elements are
+         * scattered by several threads; the sort stays stable.
+         */
+        template <class T>
+        void radix_sort(T* first, T* last, bool parallel)
+        {
+            using traits = radix_traits<T>;
+            using key_type = typename traits::key_type;
+            constexpr std::size_t n_buckets = 256;
+
+            std::size_t n = static_cast<std::size_t>(last - first);
+            xchunks chunks = parallel ? split_chunks(n) : xchunks{n, 1, n};
+            std::size_t n_chunks = chunks.count;
+
+            std::vector<T> buffer(n);
+            T* src = first;
+            T* dst = buffer.data();
+            std::vector<std::size_t> offsets(n_chunks * n_buckets);
+            for (std::size_t shift = 0; shift < 8 * sizeof(key_type); shift += 8)
+            {
+                auto digit = [shift](T v) {
+                    return static_cast<std::size_t>((traits::key(v) >> shift) & 0xFF);
+                };
+
+                std::fill(offsets.begin(), offsets.end(), std::size_t(0));
+                parallel_for_chunks(chunks, [&offsets, &digit, src](std::size_t c, std::size_t begin, std::size_t end) {
+                    std::size_t* count = offsets.data() + c * n_buckets;
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        ++count[digit(src[i])];
+                    }
+                });
+
+                // Bucket d of chunk c starts after the buckets smaller than d
+                // and after bucket d of the previous chunks.
+                bool trivial = false;
+                std::size_t offset = 0;
+                for (std::size_t d = 0; d < n_buckets && !trivial; ++d)
+                {
+                    std::size_t start = offset;
+                    for (std::size_t c = 0; c < n_chunks; ++c)
+                    {
+                        std::size_t count = offsets[c * n_buckets + d];
+                        offsets[c * n_buckets + d] = offset;
+                        offset += count;
+                    }
+                    trivial = offset - start == n;
+                }
+                if (trivial)
+                {
+                    continue;
+                }
+
+                parallel_for_chunks(chunks, [&offsets, &digit, src, dst](std::size_t c, std::size_t begin, std::size_t end) {
+                    std::size_t* offset = offsets.data() + c * n_buckets;
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        dst[offset[digit(src[i])]++] = src[i];
+                    }
+                });
+                std::swap(src, dst);
+            }
+
+            if (src != first)
+            {
+                std::copy(src, src + n, first);
+            }
+        }
+
+        template <class It>
+        inline void sort_lane_impl(It first, It last, bool parallel, std::true_type)
+        {
+            std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            if (n >= XTENSOR_RADIX_SORT_THRESHOLD)
+            {
+                auto data = std::addressof(*first);
+                radix_sort(data, data + n, parallel);
+            }
+            else if (parallel)
+            {
+                parallel_sort(first, last);
+            }
+            else
+            {
+                std::sort(first, last);
+            }
+        }
+
+        template <class It>
+        inline void sort_lane_impl(It first, It last, bool parallel, std::false_type)
+        {
+            if (parallel)
+            {
+                parallel_sort(first, last);
+            }
+            else
+            {
+                std::sort(first, last);
+            }
+        }
+
+        /**
+         * Sorts a contiguous range, with radix_sort if its elements
+         * are integral or floating point values and if it is longer
+         * than XTENSOR_RADIX_SORT_THRESHOLD, with std::sort otherwise.
+         */
+        template <class It>
+        inline void sort_lane(It first, It last, bool parallel = false)
+        {
+            using value_type = typename std::iterator_traits<It>::value_type;
+            using use_radix = std::integral_constant<bool, radix_traits<value_type>::value>;
+            sort_lane_impl(first, last, parallel, use_radix());
+        }
+    }
+
+    /**
+     * Sort flattened xexpression
+     * The sort is performed using the ``std::sort`` functions, or a radix
+     * sort for integral and floating point values when the expression has
+     * at least XTENSOR_RADIX_SORT_THRESHOLD elements. With
+     * evaluation_strategy::parallel, the radix sort splits its passes
+     * between threads; the other value types are sorted with a parallel
+     * merge sort, whose chunks are sorted with ``std::sort`` on several
+     * threads and merged pairwise.
+     *
+     * @param e xexpression to sort
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @return sorted flattened array (copy)
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto sort(const xexpression<E>& e, placeholders::xtuph /*t*/, ES /*evaluation_strategy*/ = ES())
+    {
+        const auto& de = e.derived_cast();
         E ev;
         ev.resize({ de.size() });
 
         std::copy(de.begin(), de.end(), ev.begin());
-        std::sort(ev.begin(), ev.end());
+        detail::sort_lane(ev.raw_data(), ev.raw_data() + ev.size(), detail::is_parallel_strategy<ES>::value);
 
         return ev;
     }
 
     namespace detail
     {
+        /**
+         * Calls fct(begin, end) on each contiguous run of the data of ev along its
+         * leading axis. The runs are distributed between threads if parallel is true.
+         */
         template <class E, class F>
-        void call_over_leading_axis(E& ev, F&& fct)
+        void call_over_leading_axis(E& ev, F&& fct, bool parallel = false)
         {
             using value_type = typename E::value_type;
             std::size_t n_iters = 1;
@@ -45,13 +289,27 @@ namespace xt
             {
                 n_iters = std::accumulate(ev.shape().begin(), ev.shape().end() - 1,
                                           std::size_t(1), std::multiplies<>());
-                secondary_stride = static_cast<ptrdiff_t>(ev.strides()[ev.dimension() - 2]);
+                secondary_stride = static_cast<ptrdiff_t>(ev.shape().back());
             }
             else
             {
                 n_iters = std::accumulate(ev.shape().begin() + 1, ev.shape().end(),
                                           std::size_t(1), std::multiplies<>());
-                secondary_stride = static_cast<ptrdiff_t>(ev.strides()[1]);
+                secondary_stride = static_cast<ptrdiff_t>(ev.shape().front());
+            }
+
+            if (parallel)
+            {
+                auto data = ev.raw_data();
+                std::size_t grain_size = std::max(std::size_t(1), XTENSOR_PARALLEL_GRAIN_SIZE / std::max(std::size_t(1), static_cast<std::size_t>(secondary_stride)));
+                parallel_for(0, n_iters, grain_size, [&fct, data, secondary_stride](std::size_t first, std::size_t last) {
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        ptrdiff_t offset = static_cast<ptrdiff_t>(i) * secondary_stride;
+                        fct(data + offset, data + offset + secondary_stride);
+                    }
+                });
+                return;
             }
 
             ptrdiff_t offset = 0;
@@ -75,73 +333,840 @@ namespace xt
             }
             throw std::runtime_error("Layout not supported.");
         }
+
+        /**
+         * Calls fct(begin, end) on the lanes of a contiguous array made of outer
+         * blocks of n rows of s elements, a lane being made of the elements at
+         * the same position in the rows of a block. Batches of adjacent lanes are
+         * gathered in a scratch buffer, processed and scattered back, so that
+         * each row of a block is read and written by whole cache lines.
+         */
+        template <class T, class F>
+        void call_over_strided_lanes(T* data, std::size_t outer, std::size_t n, std::size_t s, F&& fct, bool parallel)
+        {
+            std::size_t batch_size = std::max(std::size_t(1), std::size_t(64) / sizeof(T));
+            auto process_lanes = [&fct, data, n, s, batch_size](std::size_t begin, std::size_t end) {
+                std::vector<T> scratch(std::min(batch_size, end - begin) * n);
+                while (begin != end)
+                {
+                    std::size_t o = begin / s;
+                    std::size_t j = begin % s;
+                    std::size_t m = std::min(std::min(batch_size, end - begin), s - j);
+                    T* block = data + o * n * s + j;
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        for (std::size_t b = 0; b < m; ++b)
+                        {
+                            scratch[b * n + k] = block[k * s + b];
+                        }
+                    }
+                    for (std::size_t b = 0; b < m; ++b)
+                    {
+                        auto lane = scratch.begin() + static_cast<std::ptrdiff_t>(b * n);
+                        fct(lane, lane + static_cast<std::ptrdiff_t>(n));
+                    }
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        for (std::size_t b = 0; b < m; ++b)
+                        {
+                            block[k * s + b] = scratch[b * n + k];
+                        }
+                    }
+                    begin += m;
+                }
+            };
+
+            std::size_t n_lanes = outer * s;
+            if (parallel)
+            {
+                std::size_t grain_size = std::max(batch_size, XTENSOR_PARALLEL_GRAIN_SIZE / std::max(n, std::size_t(1)));
+                parallel_for(0, n_lanes, grain_size, process_lanes);
+            }
+            else if (n_lanes != 0)
+            {
+                process_lanes(0, n_lanes);
+            }
+        }
+
+        /**
+         * Calls fct(begin, end) on each lane of the contiguous array ev along
+         * axis. Lanes along the leading axis are contiguous and processed in
+         * place, the other ones are processed in a scratch buffer.
+         */
+        template <class E, class F>
+        void call_over_axis(E& ev, std::size_t axis, F&& fct, bool parallel = false)
+        {
+            if (axis == leading_axis(ev))
+            {
+                call_over_leading_axis(ev, std::forward<F>(fct), parallel);
+                return;
+            }
+
+            const auto& shape = ev.shape();
+            auto ax = shape.cbegin() + static_cast<std::ptrdiff_t>(axis);
+            std::size_t n = *ax;
+            std::size_t outer = std::accumulate(shape.cbegin(), ax, std::size_t(1), std::multiplies<std::size_t>());
+            std::size_t s = std::accumulate(ax + 1, shape.cend(), std::size_t(1), std::multiplies<std::size_t>());
+            if (ev.layout() == layout_type::column_major)
+            {
+                std::swap(outer, s);
+            }
+            call_over_strided_lanes(ev.raw_data(), outer, n, s, std::forward<F>(fct), parallel);
+        }
+    }
+
+    /**
+     * Sort xexpression (optionally along axis)
+     * The sort is performed using the ``std::sort`` functions, or a radix
+     * sort for integral and floating point values along axes longer than
+     * XTENSOR_RADIX_SORT_THRESHOLD.
+     * A copy of the xexpression is created and returned.
+     * With evaluation_strategy::parallel, the independent sorts along
+     * the axis are distributed between threads.
+     *
+     * @param e xexpression to sort
+     * @param axis axis along which sort is performed
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @return sorted array (copy)
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto sort(const xexpression<E>& e, std::size_t axis, ES es = ES())
+    {
+        constexpr bool parallel = detail::is_parallel_strategy<ES>::value;
+        using eval_type = typename E::temporary_type;
+        using value_type = typename E::value_type;
+
+        const auto& de = e.derived_cast();
+
+        if (de.dimension() == 1)
+        {
+            return sort(de, xnone(), es);
+        }
+
+        eval_type ev = de;
+        detail::call_over_axis(ev, axis, [](auto begin, auto end) { detail::sort_lane(begin, end); }, parallel);
+        return ev;
+    }
+
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto sort(const xexpression<E>& e, ES es = ES())
+    {
+        const auto& de = e.derived_cast();
+        return sort(de, de.dimension() - 1, es);
+    }
+
+    /**
+     * Selects the algorithm used by argsort.
+     */
+    enum class sorting_method
+    {
+        /// Unstable sort, using ``std::sort``
+        quick,
+        /// Stable sort, using ``std::stable_sort``: equal elements keep their order
+        stable
+    };
+
+    namespace detail
+    {
+        template <class T>
+        struct argsort_result_type
+        {
+            using type = xarray<std::size_t>;
+        };
+
+        template <class T, std::size_t N>
+        struct argsort_result_type<xtensor<T, N>>
+        {
+            using type = xtensor<std::size_t, N>;
+        };
+
+        /**
+         * Moves index to the first element of the next lane of an array of the
+         * given shape along axis, the last dimension varying the fastest.
+         * Returns false after the last lane.
+         */
+        template <class S>
+        inline bool next_lane(const S& shape, std::size_t axis, std::vector<std::size_t>& index)
+        {
+            for (std::size_t d = shape.size(); d-- != 0;)
+            {
+                if (d != axis && ++index[d] != shape[d])
+                {
+                    return true;
+                }
+                index[d] = 0;
+            }
+            return false;
+        }
+
+        /**
+         * Calls fct(index) with the index of the first element of each lane
+         * of an array of the given shape along axis. If parallel is true, the
+         * lanes are distributed between threads; fct is copied for each chunk
+         * of lanes, so that it can own the buffers it needs.
+         */
+        template <class S, class F>
+        void for_each_lane(const S& shape, std::size_t axis, F&& fct, bool parallel = false)
+        {
+            if (std::find(shape.cbegin(), shape.cend(), std::size_t(0)) != shape.cend())
+            {
+                return;
+            }
+            std::size_t dim = shape.size();
+            std::size_t n_lanes = std::accumulate(shape.cbegin(), shape.cend(), std::size_t(1), std::multiplies<std::size_t>()) / shape[axis];
+
+            auto process_lanes = [&fct, &shape, axis, dim](std::size_t begin, std::size_t end) {
+                std::decay_t<F> f = fct;
+                std::vector<std::size_t> index(dim, 0);
+                std::size_t l = begin;
+                for (std::size_t d = dim; d-- != 0;)
+                {
+                    if (d != axis)
+                    {
+                        index[d] = l % shape[d];
+                        l /= shape[d];
+                    }
+                }
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    f(index);
+                    next_lane(shape, axis, index);
+                }
+            };
+
+            if (parallel)
+            {
+                std::size_t grain_size = std::max(std::size_t(1), XTENSOR_PARALLEL_GRAIN_SIZE / shape[axis]);
+                parallel_for(0, n_lanes, grain_size, process_lanes);
+            }
+            else
+            {
+                process_lanes(0, n_lanes);
+            }
+        }
+
+        template <class S>
+        inline std::size_t lane_offset(const S& strides, const std::vector<std::size_t>& index)
+        {
+            return std::inner_product(index.cbegin(), index.cend(), strides.cbegin(), std::size_t(0));
+        }
+
+        /**
+         * Calls fct(first, last, value) for each lane of the container ev along
+         * axis, where [first, last) holds the indices 0 to n - 1 and value(i)
+         * returns the i-th element of the lane. The first indices left in the
+         * range by fct are written to the corresponding lane of result, which
+         * has the shape of ev, except along axis.
+         */
+        template <class E, class R, class F>
+        void arg_over_axis(const E& ev, std::size_t axis, R& result, F&& fct)
+        {
+            std::size_t n = ev.shape()[axis];
+            std::size_t k = result.shape()[axis];
+            std::size_t in_stride = ev.strides()[axis];
+            std::size_t out_stride = result.strides()[axis];
+            auto data = ev.raw_data() + ev.raw_data_offset();
+            auto out = result.raw_data();
+            std::vector<std::size_t> idx(n);
+            for_each_lane(ev.shape(), axis, [&](const std::vector<std::size_t>& index) {
+                auto lane = data + lane_offset(ev.strides(), index);
+                auto value = [lane, in_stride](std::size_t i) { return lane[i * in_stride]; };
+                std::iota(idx.begin(), idx.end(), std::size_t(0));
+                fct(idx.begin(), idx.end(), value);
+                auto res = out + lane_offset(result.strides(), index);
+                for (std::size_t i = 0; i < k; ++i)
+                {
+                    res[i * out_stride] = idx[i];
+                }
+            });
+        }
+
+        template <class S>
+        inline void check_kth(const S& shape, std::size_t axis, std::size_t kth)
+        {
+            if (axis >= shape.size() || kth >= shape[axis])
+            {
+                throw std::out_of_range("kth out of bounds");
+            }
+        }
+    }
+
+    /**
+     * Returns the indices that sort the xexpression along axis
+     *
+     * @param e xexpression to argsort
+     * @param axis axis along which argsort is performed
+     * @param method sorting_method::quick (default) or sorting_method::stable
+     *
+     * @return array of the same shape as e, each lane holding the indices
+     *         that sort the corresponding lane of e
+     */
+    template <class E>
+    auto argsort(const xexpression<E>& e, std::size_t axis, sorting_method method = sorting_method::quick)
+    {
+        auto&& ev = eval(e.derived_cast());
+        using result_type = typename detail::argsort_result_type<std::decay_t<decltype(ev)>>::type;
+
+        result_type result = result_type::from_shape(ev.shape());
+        detail::arg_over_axis(ev, axis, result, [method](auto first, auto last, auto value) {
+            auto cmp = [&value](std::size_t i, std::size_t j) { return value(i) < value(j); };
+            if (method == sorting_method::stable)
+            {
+                std::stable_sort(first, last, cmp);
+            }
+            else
+            {
+                std::sort(first, last, cmp);
+            }
+        });
+        return result;
+    }
+
+    /**
+     * Returns the indices that sort the xexpression along its last axis
+     *
+     * @param e xexpression to argsort
+     * @param method sorting_method::quick (default) or sorting_method::stable
+     */
+    template <class E>
+    auto argsort(const xexpression<E>& e, sorting_method method = sorting_method::quick)
+    {
+        const auto& de = e.derived_cast();
+        return argsort(de, de.dimension() - 1, method);
+    }
+
+    /**
+     * Returns the indices that sort the flattened xexpression
+     *
+     * @param e xexpression to argsort
+     * @param method sorting_method::quick (default) or sorting_method::stable
+     *
+     * @return 1D array of indices into the flattened xexpression
+     */
+    template <class E>
+    auto argsort(const xexpression<E>& e, placeholders::xtuph /*t*/, sorting_method method = sorting_method::quick)
+    {
+        using value_type = typename E::value_type;
+        const auto& de = e.derived_cast();
+        std::vector<value_type> flat(de.cbegin(), de.cend());
+        std::array<std::size_t, 1> shape = {flat.size()};
+        xtensor<std::size_t, 1> result(shape);
+        std::iota(result.begin(), result.end(), std::size_t(0));
+        auto cmp = [&flat](std::size_t i, std::size_t j) { return flat[i] < flat[j]; };
+        if (method == sorting_method::stable)
+        {
+            std::stable_sort(result.begin(), result.end(), cmp);
+        }
+        else
+        {
+            std::sort(result.begin(), result.end(), cmp);
+        }
+        return result;
+    }
+
+    /**
+     * Partially sort xexpression along axis
+     * Each lane along axis is rearranged with ``std::nth_element``, so that
+     * its kth element is the one that would be there if the lane was sorted,
+     * the elements before are not greater and the elements after are not
+     * smaller. This runs in linear time per lane.
+     *
+     * @param e xexpression to partition
+     * @param kth index of the element to put in its sorted position
+     * @param axis axis along which the partition is performed
+     *
+     * @return partitioned array (copy)
+     */
+    template <class E>
+    auto partition(const xexpression<E>& e, std::size_t kth, std::size_t axis)
+    {
+        using eval_type = typename E::temporary_type;
+        const auto& de = e.derived_cast();
+        detail::check_kth(de.shape(), axis, kth);
+
+        eval_type ev = de;
+        detail::call_over_axis(ev, axis, [kth](auto begin, auto end) {
+            std::nth_element(begin, begin + static_cast<std::ptrdiff_t>(kth), end);
+        });
+        return ev;
+    }
+
+    /**
+     * Partially sort xexpression along its last axis
+     *
+     * @param e xexpression to partition
+     * @param kth index of the element to put in its sorted position
+     */
+    template <class E>
+    auto partition(const xexpression<E>& e, std::size_t kth)
+    {
+        const auto& de = e.derived_cast();
+        return partition(de, kth, de.dimension() - 1);
+    }
+
+    /**
+     * Partially sort flattened xexpression
+     *
+     * @param e xexpression to partition
+     * @param kth index of the element to put in its sorted position
+     *
+     * @return partitioned flattened array (copy)
+     */
+    template <class E>
+    auto partition(const xexpression<E>& e, std::size_t kth, placeholders::xtuph /*t*/)
+    {
+        using value_type = typename E::value_type;
+        const auto& de = e.derived_cast();
+        std::array<std::size_t, 1> shape = {de.size()};
+        detail::check_kth(shape, 0, kth);
+
+        xtensor<value_type, 1> ev(shape);
+        std::copy(de.cbegin(), de.cend(), ev.begin());
+        std::nth_element(ev.begin(), ev.begin() + static_cast<std::ptrdiff_t>(kth), ev.end());
+        return ev;
+    }
+
+    /**
+     * Returns the indices that partition the xexpression along axis
+     * The indices of each lane are rearranged with ``std::nth_element``,
+     * as in partition. This runs in linear time per lane.
+     *
+     * @param e xexpression to argpartition
+     * @param kth index of the element to put in its sorted position
+     * @param axis axis along which the partition is performed
+     *
+     * @return array of the same shape as e holding the indices
+     */
+    template <class E>
+    auto argpartition(const xexpression<E>& e, std::size_t kth, std::size_t axis)
+    {
+        auto&& ev = eval(e.derived_cast());
+        using result_type = typename detail::argsort_result_type<std::decay_t<decltype(ev)>>::type;
+        detail::check_kth(ev.shape(), axis, kth);
+
+        result_type result = result_type::from_shape(ev.shape());
+        detail::arg_over_axis(ev, axis, result, [kth](auto first, auto last, auto value) {
+            std::nth_element(first, first + static_cast<std::ptrdiff_t>(kth), last,
+                             [&value](std::size_t i, std::size_t j) { return value(i) < value(j); });
+        });
+        return result;
+    }
+
+    /**
+     * Returns the indices that partition the xexpression along its last axis
+     *
+     * @param e xexpression to argpartition
+     * @param kth index of the element to put in its sorted position
+     */
+    template <class E>
+    auto argpartition(const xexpression<E>& e, std::size_t kth)
+    {
+        const auto& de = e.derived_cast();
+        return argpartition(de, kth, de.dimension() - 1);
+    }
+
+    /**
+     * Returns the indices that partition the flattened xexpression
+     *
+     * @param e xexpression to argpartition
+     * @param kth index of the element to put in its sorted position
+     *
+     * @return 1D array of indices into the flattened xexpression
+     */
+    template <class E>
+    auto argpartition(const xexpression<E>& e, std::size_t kth, placeholders::xtuph /*t*/)
+    {
+        using value_type = typename E::value_type;
+        const auto& de = e.derived_cast();
+        std::vector<value_type> flat(de.cbegin(), de.cend());
+        std::array<std::size_t, 1> shape = {flat.size()};
+        detail::check_kth(shape, 0, kth);
+
+        xtensor<std::size_t, 1> result(shape);
+        std::iota(result.begin(), result.end(), std::size_t(0));
+        std::nth_element(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(kth), result.end(),
+                         [&flat](std::size_t i, std::size_t j) { return flat[i] < flat[j]; });
+        return result;
+    }
+
+    /**
+     * Selects the k largest elements of each lane of the xexpression along axis
+     * The indices of each lane are partially sorted with ``std::partial_sort``,
+     * which runs in O(n log k) per lane instead of sorting the whole lane.
+     * Equal elements are ordered by increasing index.
+     *
+     * @param e xexpression to select from
+     * @param k number of elements to select in each lane
+     * @param axis axis along which the selection is performed
+     *
+     * @return pair of arrays of the shape of e with a length of k along axis,
+     *         holding the values in decreasing order and their indices in e
+     */
+    template <class E>
+    auto topk(const xexpression<E>& e, std::size_t k, std::size_t axis)
+    {
+        auto&& ev = eval(e.derived_cast());
+        using eval_type = std::decay_t<decltype(ev)>;
+        using value_container = typename eval_type::temporary_type;
+        using index_container = typename detail::argsort_result_type<eval_type>::type;
+        if (axis >= ev.dimension() || k > ev.shape()[axis])
+        {
+            throw std::out_of_range("k out of bounds");
+        }
+
+        auto shape = ev.shape();
+        shape[axis] = k;
+        auto indices = index_container::from_shape(shape);
+        detail::arg_over_axis(ev, axis, indices, [k](auto first, auto last, auto value) {
+            std::partial_sort(first, first + static_cast<std::ptrdiff_t>(k), last, [&value](std::size_t i, std::size_t j) {
+                auto vi = value(i);
+                auto vj = value(j);
+                return vj < vi || (!(vi < vj) && i < j);
+            });
+        });
+
+        auto values = value_container::from_shape(shape);
+        std::size_t in_stride = ev.strides()[axis];
+        std::size_t idx_stride = indices.strides()[axis];
+        std::size_t out_stride = values.strides()[axis];
+        auto data = ev.raw_data() + ev.raw_data_offset();
+        detail::for_each_lane(shape, axis, [&](const std::vector<std::size_t>& index) {
+            auto lane = data + detail::lane_offset(ev.strides(), index);
+            auto idx = indices.raw_data() + detail::lane_offset(indices.strides(), index);
+            auto res = values.raw_data() + detail::lane_offset(values.strides(), index);
+            for (std::size_t i = 0; i < k; ++i)
+            {
+                res[i * out_stride] = lane[idx[i * idx_stride] * in_stride];
+            }
+        });
+        return std::make_pair(std::move(values), std::move(indices));
+    }
+
+    /**
+     * Selects the k largest elements of each lane of the xexpression along its last axis
+     *
+     * @param e xexpression to select from
+     * @param k number of elements to select in each lane
+     */
+    template <class E>
+    auto topk(const xexpression<E>& e, std::size_t k)
+    {
+        const auto& de = e.derived_cast();
+        return topk(de, k, de.dimension() - 1);
+    }
+
+    namespace detail
+    {
+        template <class T>
+        using quantile_value_t = std::conditional_t<std::is_floating_point<T>::value, T, double>;
+
+        template <class E, class R, bool multi>
+        struct quantile_result_type
+        {
+            using type = xarray<R>;
+        };
+
+        template <class T, std::size_t N, class R, bool multi>
+        struct quantile_result_type<xtensor<T, N>, R, multi>
+        {
+            using type = xtensor<R, multi ? N : N - 1>;
+        };
+
+        /**
+         * Ranks and interpolation weights of quantiles of n elements, computed
+         * with linear interpolation between the closest ranks like numpy does
+         * by default.
+         */
+        class quantile_plan
+        {
+        public:
+
+            template <class Q>
+            quantile_plan(const Q& q, std::size_t n)
+            {
+                if (n == 0)
+                {
+                    throw std::runtime_error("quantile of an empty sequence");
+                }
+                for (double p : q)
+                {
+                    if (!(p >= 0. && p <= 1.))
+                    {
+                        throw std::out_of_range("quantile must be in [0, 1]");
+                    }
+                    double pos = p * static_cast<double>(n - 1);
+                    std::size_t lo = std::min(static_cast<std::size_t>(pos), n - 1);
+                    m_lo.push_back(lo);
+                    m_weight.push_back(pos - static_cast<double>(lo));
+                    m_ranks.push_back(lo);
+                    if (lo + 1 < n)
+                    {
+                        m_ranks.push_back(lo + 1);
+                    }
+                }
+                std::sort(m_ranks.begin(), m_ranks.end());
+                m_ranks.erase(std::unique(m_ranks.begin(), m_ranks.end()), m_ranks.end());
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_lo.size();
+            }
+
+            /**
+             * Moves the elements of the ranks needed by the quantiles to their
+             * sorted position in [first, last), each nth_element only
+             * partitioning what follows the previous rank, and writes the
+             * i-th quantile to out[i * stride].
+             */
+            template <class It, class O>
+            void apply(It first, It last, O out, std::size_t stride) const
+            {
+                using result_type = std::decay_t<decltype(*out)>;
+                It begin = first;
+                for (std::size_t r : m_ranks)
+                {
+                    It nth = first + static_cast<std::ptrdiff_t>(r);
+                    std::nth_element(begin, nth, last);
+                    begin = nth + 1;
+                }
+                for (std::size_t i = 0; i < m_lo.size(); ++i)
+                {
+                    It lo = first + static_cast<std::ptrdiff_t>(m_lo[i]);
+                    result_type v = static_cast<result_type>(*lo);
+                    if (m_weight[i] > 0.)
+                    {
+                        v += static_cast<result_type>(m_weight[i]) * (static_cast<result_type>(*(lo + 1)) - v);
+                    }
+                    out[i * stride] = v;
+                }
+            }
+
+        private:
+
+            std::vector<std::size_t> m_lo;
+            std::vector<double> m_weight;
+            std::vector<std::size_t> m_ranks;
+        };
+
+        /**
+         * Computes the quantiles q of the lanes of e along axis. Each lane is
+         * copied to a scratch buffer where its ranks are selected. With multi,
+         * the quantiles are stacked along a new first axis of the result.
+         */
+        template <bool multi, class E, class Q>
+        auto quantile_impl(const xexpression<E>& e, const Q& q, std::size_t axis, bool parallel)
+        {
+            if (axis >= e.derived_cast().dimension())
+            {
+                throw std::out_of_range("axis out of bounds");
+            }
+
+            auto&& ev = eval(e.derived_cast());
+            using eval_type = std::decay_t<decltype(ev)>;
+            using value_type = typename eval_type::value_type;
+            using result_type = typename quantile_result_type<eval_type, quantile_value_t<value_type>, multi>::type;
+
+            std::size_t n = ev.shape()[axis];
+            quantile_plan plan(q, n);
+
+            xt::dynamic_shape<std::size_t> shape(ev.shape().cbegin(), ev.shape().cend());
+            shape.erase(shape.begin() + static_cast<std::ptrdiff_t>(axis));
+            if (multi)
+            {
+                shape.insert(shape.begin(), plan.size());
+            }
+            result_type result = result_type::from_shape(shape);
+
+            // strides of the result for each dimension of ev
+            std::size_t shift = multi ? 1 : 0;
+            std::size_t q_stride = multi ? result.strides()[0] : 0;
+            std::vector<std::size_t> out_strides(ev.dimension(), 0);
+            for (std::size_t d = 0; d < ev.dimension(); ++d)
+            {
+                if (d != axis)
+                {
+                    out_strides[d] = result.strides()[(d < axis ? d : d - 1) + shift];
+                }
+            }
+
+            std::size_t in_stride = ev.strides()[axis];
+            auto data = ev.raw_data() + ev.raw_data_offset();
+            auto out = result.raw_data();
+            for_each_lane(ev.shape(), axis, [&, scratch = std::vector<value_type>(n)](const std::vector<std::size_t>& index) mutable {
+                auto lane = data + lane_offset(ev.strides(), index);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    scratch[i] = lane[i * in_stride];
+                }
+                plan.apply(scratch.begin(), scratch.end(), out + lane_offset(out_strides, index), q_stride);
+            }, parallel);
+            return result;
+        }
+
+        template <class E, class Q, class O>
+        inline void flat_quantile_impl(const xexpression<E>& e, const Q& q, O out)
+        {
+            using value_type = typename E::value_type;
+            const auto& de = e.derived_cast();
+            std::vector<value_type> scratch(de.cbegin(), de.cend());
+            quantile_plan plan(q, scratch.size());
+            plan.apply(scratch.begin(), scratch.end(), out, 1);
+        }
+    }
+
+    /**
+     * Computes the quantile q of the xexpression along axis
+     * The quantile is interpolated linearly between the two closest ranks,
+     * which are selected with ``std::nth_element`` in a copy of each lane, in
+     * linear time per lane. Integral values give double quantiles.
+     *
+     * @param e xexpression to compute the quantile of
+     * @param q quantile to compute, in [0, 1]
+     * @param axis axis along which the quantile is computed
+     * @param evaluation_strategy immediate (default) or parallel, to
+     *        distribute the lanes between threads
+     *
+     * @return array with the shape of e, axis removed
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto quantile(const xexpression<E>& e, double q, std::size_t axis, ES /*evaluation_strategy*/ = ES())
+    {
+        std::array<double, 1> qs = {q};
+        return detail::quantile_impl<false>(e, qs, axis, detail::is_parallel_strategy<ES>::value);
+    }
+
+    /**
+     * Computes several quantiles of the xexpression along axis
+     * The ranks needed by all the quantiles are selected in a single pass
+     * over each lane.
+     *
+     * @param e xexpression to compute the quantiles of
+     * @param q quantiles to compute, in [0, 1]
+     * @param axis axis along which the quantiles are computed
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @return array whose first axis holds the quantiles, followed by the
+     *         axes of e except axis
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto quantile(const xexpression<E>& e, const std::vector<double>& q, std::size_t axis, ES /*evaluation_strategy*/ = ES())
+    {
+        return detail::quantile_impl<true>(e, q, axis, detail::is_parallel_strategy<ES>::value);
+    }
+
+    /**
+     * Computes the quantile q of the flattened xexpression
+     *
+     * @param e xexpression to compute the quantile of
+     * @param q quantile to compute, in [0, 1]
+     *
+     * @return the quantile
+     */
+    template <class E>
+    auto quantile(const xexpression<E>& e, double q)
+    {
+        detail::quantile_value_t<typename E::value_type> res;
+        std::array<double, 1> qs = {q};
+        detail::flat_quantile_impl(e, qs, &res);
+        return res;
+    }
+
+    /**
+     * Computes several quantiles of the flattened xexpression
+     *
+     * @param e xexpression to compute the quantiles of
+     * @param q quantiles to compute, in [0, 1]
+     *
+     * @return 1-D array holding the quantiles
+     */
+    template <class E>
+    auto quantile(const xexpression<E>& e, const std::vector<double>& q)
+    {
+        std::array<std::size_t, 1> shape = {q.size()};
+        xtensor<detail::quantile_value_t<typename E::value_type>, 1> res(shape);
+        detail::flat_quantile_impl(e, q, res.raw_data());
+        return res;
+    }
+
+    /**
+     * Computes the median of the xexpression along axis
+     *
+     * @param e xexpression to compute the median of
+     * @param axis axis along which the median is computed
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @sa quantile
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto median(const xexpression<E>& e, std::size_t axis, ES es = ES())
+    {
+        return quantile(e, 0.5, axis, es);
     }
 
     /**
-     * Sort xexpression (optionally along axis)
-     * The sort is performed using the ``std::sort`` functions.
-     * A copy of the xexpression is created and returned.
-     *
-     * @param e xexpression to sort
-     * @param axis axis along which sort is performed
+     * Computes the median of the flattened xexpression
      *
-     * @return sorted array (copy)
+     * @param e xexpression to compute the median of
      */
     template <class E>
-    auto sort(const xexpression<E>& e, std::size_t axis)
+    auto median(const xexpression<E>& e)
     {
-        using eval_type = typename E::temporary_type;
-        using value_type = typename E::value_type;
-
-        const auto& de = e.derived_cast();
-
-        if (de.dimension() == 1)
-        {
-            return sort(de, xnone());
-        }
-
-        eval_type ev;
-
-        if (axis != detail::leading_axis(ev))
-        {
-            auto axis_numbers = arange<std::size_t>(de.shape().size());
-            std::vector<std::size_t> permutation(axis_numbers.begin(), axis_numbers.end());
-            permutation.erase(permutation.begin() + ptrdiff_t(axis));
-            if (de.layout() == layout_type::row_major)
-            {
-                permutation.push_back(axis);
-            }
-            else
-            {
-                permutation.insert(permutation.begin(), axis);
-            }
+        return quantile(e, 0.5);
+    }
 
-            // TODO find a more clever way to get reverse permutation?
-            std::vector<std::size_t> reverse_permutation;
-            for (auto el : axis_numbers)
-            {
-                auto it = std::find(permutation.begin(), permutation.end(), el);
-                reverse_permutation.push_back(std::size_t(std::distance(permutation.begin(), it)));
-            }
+    /**
+     * Computes the percentile p of the xexpression along axis
+     *
+     * @param e xexpression to compute the percentile of
+     * @param p percentile to compute, in [0, 100]
+     * @param axis axis along which the percentile is computed
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @sa quantile
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto percentile(const xexpression<E>& e, double p, std::size_t axis, ES es = ES())
+    {
+        return quantile(e, p / 100., axis, es);
+    }
 
-            ev = transpose(de, permutation);
-            detail::call_over_leading_axis(ev, [](auto begin, auto end) { std::sort(begin, end); });
-            ev = transpose(ev, reverse_permutation);
-            return ev;
-        }
-        else
-        {
-            ev = de;
-            detail::call_over_leading_axis(ev, [](auto begin, auto end) { std::sort(begin, end); });
-            return ev;
-        }
+    /**
+     * Computes several percentiles of the xexpression along axis
+     *
+     * @param e xexpression to compute the percentiles of
+     * @param p percentiles to compute, in [0, 100]
+     * @param axis axis along which the percentiles are computed
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @sa quantile
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto percentile(const xexpression<E>& e, const std::vector<double>& p, std::size_t axis, ES es = ES())
+    {
+        std::vector<double> q(p.size());
+        std::transform(p.cbegin(), p.cend(), q.begin(), [](double v) { return v / 100.; });
+        return quantile(e, q, axis, es);
     }
 
+    /**
+     * Computes the percentile p of the flattened xexpression
+     *
+     * @param e xexpression to compute the percentile of
+     * @param p percentile to compute, in [0, 100]
+     */
     template <class E>
-    auto sort(const xexpression<E>& e)
+    auto percentile(const xexpression<E>& e, double p)
     {
-        const auto& de = e.derived_cast();
-        return sort(de, de.dimension() - 1);
+        return quantile(e, p / 100.);
     }
 
     namespace detail
@@ -162,7 +1187,7 @@ namespace xt
         inline std::size_t cmp_idx(IT iter, IT end, ptrdiff_t inc, F&& cmp)
         {
             std::size_t idx = 0;
-            double min = *iter;
+            auto min = *iter;
             iter += inc;
             for (std::size_t i = 1; iter < end; iter += inc, ++i)
             {
@@ -175,9 +1200,163 @@ namespace xt
             return idx;
         }
 
+        template <class F>
+        struct arg_simd_op
+        {
+            static constexpr bool value = false;
+        };
+
+        template <class T>
+        struct arg_simd_op<std::less<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const B& best, const B& v)
+            {
+                return xsimd::select(v < best, v, best);
+            }
+        };
+
+        template <class T>
+        struct arg_simd_op<std::greater<T>>
+        {
+            static constexpr bool value = true;
+
+            template <class B>
+            static B apply(const B& best, const B& v)
+            {
+                return xsimd::select(v > best, v, best);
+            }
+        };
+
+        template <class F, class T>
+        struct use_simd_arg
+            : std::integral_constant<bool, arg_simd_op<F>::value && std::is_arithmetic<T>::value &&
+                                           !std::is_same<T, bool>::value && (xsimd::simd_traits<T>::size > 1)>
+        {
+        };
+
+        template <class T, class F>
+        inline std::size_t arg_contiguous(const T* data, std::size_t n, F& cmp, std::false_type)
+        {
+            std::size_t idx = 0;
+            T best = data[0];
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                if (cmp(data[i], best))
+                {
+                    best = data[i];
+                    idx = i;
+                }
+            }
+            return idx;
+        }
+
+        /**
+         * Returns the index of the first best element of the n contiguous
+         * elements starting at data. Each simd lane keeps the best element it
+         * has seen in the current block of arg_block_size elements; at the end
+         * of the block, the lanes are compared with the best element so far,
+         * and only the block where it was found is scanned again to find its
+         * index. Like the scalar loop, NaN values are skipped unless they come
+         * first.
+         */
+        template <class T, class F>
+        inline std::size_t arg_contiguous(const T* data, std::size_t n, F& cmp, std::true_type)
+        {
+            using simd_type = xsimd::simd_type<T>;
+            constexpr std::size_t simd_size = simd_type::size;
+            constexpr std::size_t arg_block_size = 1024;
+            using op = arg_simd_op<std::decay_t<F>>;
+
+            T best = data[0];
+            std::size_t best_block = 0;
+            std::size_t n_simd = n - n % simd_size;
+            for (std::size_t block = 0; block < n_simd; block += arg_block_size)
+            {
+                std::size_t block_end = std::min(n_simd, block + arg_block_size);
+                simd_type acc = xsimd::set_simd(best);
+                for (std::size_t i = block; i < block_end; i += simd_size)
+                {
+                    acc = op::apply(acc, xsimd::load_simd<T>(data + i, xsimd::unaligned_mode()));
+                }
+                T lanes[simd_size];
+                xsimd::store_simd<T>(lanes, acc, xsimd::unaligned_mode());
+                for (std::size_t k = 0; k < simd_size; ++k)
+                {
+                    if (cmp(lanes[k], best))
+                    {
+                        best = lanes[k];
+                        best_block = block;
+                    }
+                }
+            }
+
+            std::size_t idx = best_block;
+            for (std::size_t i = best_block; i < n_simd; ++i)
+            {
+                if (data[i] == best)
+                {
+                    idx = i;
+                    break;
+                }
+            }
+            for (std::size_t i = n_simd; i < n; ++i)
+            {
+                if (cmp(data[i], best))
+                {
+                    best = data[i];
+                    idx = i;
+                }
+            }
+            return idx;
+        }
+
+        template <class T, class F>
+        inline std::size_t arg_contiguous(const T* data, std::size_t n, F& cmp)
+        {
+            return arg_contiguous(data, n, cmp, use_simd_arg<std::decay_t<F>, T>());
+        }
+
+        /**
+         * Splits the n contiguous elements starting at data in chunks whose
+         * best elements are searched by several threads, then keeps the
+         * first best of these elements.
+         */
+        template <class T, class F>
+        inline std::size_t arg_contiguous_parallel(const T* data, std::size_t n, F& cmp)
+        {
+            xchunks chunks = split_chunks(n);
+            if (chunks.count < 2)
+            {
+                return arg_contiguous(data, n, cmp);
+            }
+
+            std::vector<std::size_t> chunk_idx(chunks.count);
+            parallel_for_chunks(chunks, [&chunk_idx, &cmp, data](std::size_t c, std::size_t first, std::size_t last) {
+                chunk_idx[c] = first + arg_contiguous(data + first, last - first, cmp);
+            });
+
+            std::size_t idx = chunk_idx[0];
+            for (std::size_t c = 1; c < chunks.count; ++c)
+            {
+                if (cmp(data[chunk_idx[c]], data[idx]))
+                {
+                    idx = chunk_idx[c];
+                }
+            }
+            return idx;
+        }
+
         template <class E, class F>
-        xtensor<std::size_t, 0> arg_func_impl(const E& e, F&& f)
+        xtensor<std::size_t, 0> arg_func_impl(const E& e, F&& f, bool parallel = false)
         {
+            if (e.size() != 0 && e.layout() == DEFAULT_LAYOUT)
+            {
+                auto data = e.raw_data() + e.raw_data_offset();
+                return parallel ? arg_contiguous_parallel(data, e.size(), f) : arg_contiguous(data, e.size(), f);
+            }
             return cmp_idx(e.template begin<DEFAULT_LAYOUT>(),
                            e.template end<DEFAULT_LAYOUT>(), 1,
                            std::forward<F>(f));
@@ -187,7 +1366,6 @@ namespace xt
         typename argfunc_result_type<E>::type
         arg_func_impl(const E& e, std::size_t axis, F&& cmp)
         {
-            using value_type = typename E::value_type;
             using result_type = typename argfunc_result_type<E>::type;
 
             if (e.dimension() == 1)
@@ -202,18 +1380,7 @@ namespace xt
             auto result_iter = result.begin();
 
             auto arg_func_lambda = [&result_iter, &cmp](auto begin, auto end) {
-                std::size_t idx = 0;
-                value_type val = *begin;
-                ++begin;
-                for (std::size_t i = 1; begin != end; ++begin, ++i)
-                {
-                    if (cmp(*begin, val))
-                    {
-                        val = *begin;
-                        idx = i;
-                    }
-                }
-                *result_iter = idx;
+                *result_iter = arg_contiguous(begin, static_cast<std::size_t>(end - begin), cmp);
                 ++result_iter;
             };
 
@@ -246,12 +1413,23 @@ namespace xt
         }
     }
 
-    template <class E>
-    auto argmin(const xexpression<E>& e)
+    /**
+     * Find position of minimal value in flattened xexpression
+     * Contiguous expressions are searched with simd instructions; with
+     * evaluation_strategy::parallel, chunks are searched on several threads.
+     *
+     * @param e xexpression to compute argmin on
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @return returns 0-D xtensor with the position of the first minimal value
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto argmin(const xexpression<E>& e, ES /*evaluation_strategy*/ = ES())
     {
         using value_type = typename E::value_type;
         auto&& ed = eval(e.derived_cast());
-        return detail::arg_func_impl(ed, std::less<value_type>());
+        return detail::arg_func_impl(ed, std::less<value_type>(), detail::is_parallel_strategy<ES>::value);
     }
 
     /**
@@ -270,12 +1448,23 @@ namespace xt
         return detail::arg_func_impl(ed, axis, std::less<value_type>());
     }
 
-    template <class E>
-    auto argmax(const xexpression<E>& e)
+    /**
+     * Find position of maximal value in flattened xexpression
+     * Contiguous expressions are searched with simd instructions; with
+     * evaluation_strategy::parallel, chunks are searched on several threads.
+     *
+     * @param e xexpression to compute argmax on
+     * @param evaluation_strategy immediate (default) or parallel
+     *
+     * @return returns 0-D xtensor with the position of the first maximal value
+     */
+    template <class E, class ES = evaluation_strategy::immediate,
+              class = std::enable_if_t<std::is_base_of<evaluation_strategy::base, ES>::value, int>>
+    auto argmax(const xexpression<E>& e, ES /*evaluation_strategy*/ = ES())
     {
         using value_type = typename E::value_type;
         auto&& ed = eval(e.derived_cast());
-        return detail::arg_func_impl(ed, std::greater<value_type>());
+        return detail::arg_func_impl(ed, std::greater<value_type>(), detail::is_parallel_strategy<ES>::value);
     }
 
     /**
@@ -293,6 +1482,300 @@ namespace xt
         auto&& ed = eval(e.derived_cast());
         return detail::arg_func_impl(ed, axis, std::greater<value_type>());
     }
+
+    /**
+     * Selects the insertion points returned by searchsorted.
+     */
+    enum class search_side
+    {
+        /// First position where the value can be inserted
+        left,
+        /// Last position where the value can be inserted
+        right
+    };
+
+    namespace detail
+    {
+        template <class T>
+        inline xtensor<T, 1> to_xtensor(const std::vector<T>& v)
+        {
+            std::array<std::size_t, 1> shape = {v.size()};
+            xtensor<T, 1> res(shape);
+            std::copy(v.cbegin(), v.cend(), res.begin());
+            return res;
+        }
+
+        /**
+         * Returns the sorted distinct elements of the flattened expression.
+         * If counts is not null, the number of occurrences of each distinct
+         * element is pushed back to it. If inverse is not null, it is resized
+         * to the size of the expression and receives the position of each
+         * element in the returned values.
+         */
+        template <class E>
+        std::vector<typename E::value_type> sorted_unique(const E& e,
+                                                          std::vector<std::size_t>* counts,
+                                                          std::vector<std::size_t>* inverse)
+        {
+            using value_type = typename E::value_type;
+            std::vector<value_type> flat(e.cbegin(), e.cend());
+            std::vector<value_type> values;
+
+            auto push = [&values, counts](const value_type& v) {
+                if (values.empty() || values.back() < v)
+                {
+                    values.push_back(v);
+                    if (counts != nullptr)
+                    {
+                        counts->push_back(0);
+                    }
+                }
+                if (counts != nullptr)
+                {
+                    ++counts->back();
+                }
+            };
+
+            if (inverse != nullptr)
+            {
+                std::vector<std::size_t> order(flat.size());
+                std::iota(order.begin(), order.end(), std::size_t(0));
+                std::stable_sort(order.begin(), order.end(),
+                                 [&flat](std::size_t i, std::size_t j) { return flat[i] < flat[j]; });
+                inverse->resize(flat.size());
+                for (std::size_t i : order)
+                {
+                    push(flat[i]);
+                    (*inverse)[i] = values.size() - 1;
+                }
+            }
+            else
+            {
+                sort_lane(flat.begin(), flat.end());
+                for (const auto& v : flat)
+                {
+                    push(v);
+                }
+            }
+            return values;
+        }
+
+        constexpr std::size_t searchsorted_batch_size = 16;
+
+        /**
+         * Branchless binary search of a batch of m queries in the n > 0 sorted
+         * elements starting at data. The number of steps only depends on n, so
+         * the steps of the queries of a batch are interleaved: their loads are
+         * issued together, and the inner loops can be vectorized with gathers.
+         */
+        template <class T, class U>
+        inline void searchsorted_batch(const T* data, std::size_t n, const U* queries, std::size_t m,
+                                       std::size_t* res, search_side side)
+        {
+            std::size_t pos[searchsorted_batch_size] = {};
+            if (side == search_side::left)
+            {
+                for (std::size_t len = n; len > 1; len -= len / 2)
+                {
+                    std::size_t half = len / 2;
+                    for (std::size_t j = 0; j < m; ++j)
+                    {
+                        pos[j] += data[pos[j] + half] < queries[j] ? half : std::size_t(0);
+                    }
+                }
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    res[j] = pos[j] + (data[pos[j]] < queries[j] ? std::size_t(1) : std::size_t(0));
+                }
+            }
+            else
+            {
+                for (std::size_t len = n; len > 1; len -= len / 2)
+                {
+                    std::size_t half = len / 2;
+                    for (std::size_t j = 0; j < m; ++j)
+                    {
+                        pos[j] += queries[j] < data[pos[j] + half] ? std::size_t(0) : half;
+                    }
+                }
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    res[j] = pos[j] + (queries[j] < data[pos[j]] ? std::size_t(0) : std::size_t(1));
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the sorted distinct elements of the flattened xexpression
+     * The elements are sorted with sort and duplicates are removed in a
+     * single pass.
+     *
+     * @param e xexpression to find the distinct elements of
+     *
+     * @return 1-D array of the distinct elements
+     */
+    template <class E>
+    auto unique(const xexpression<E>& e)
+    {
+        return detail::to_xtensor(detail::sorted_unique(e.derived_cast(), nullptr, nullptr));
+    }
+
+    /**
+     * Returns the sorted distinct elements of the flattened xexpression
+     * and their number of occurrences
+     *
+     * @param e xexpression to find the distinct elements of
+     *
+     * @return a tuple of two 1-D arrays, the distinct elements and the
+     *         number of occurrences of each of them
+     */
+    template <class E>
+    auto unique_counts(const xexpression<E>& e)
+    {
+        std::vector<std::size_t> counts;
+        auto values = detail::sorted_unique(e.derived_cast(), &counts, nullptr);
+        return std::make_tuple(detail::to_xtensor(values), detail::to_xtensor(counts));
+    }
+
+    /**
+     * Returns the sorted distinct elements of the flattened xexpression
+     * and the position of each element of e among them
+     *
+     * @param e xexpression to find the distinct elements of
+     *
+     * @return a tuple of two 1-D arrays, the distinct elements and the
+     *         index in the distinct elements of each element of the
+     *         flattened e, so that the former indexed by the latter gives
+     *         back e
+     */
+    template <class E>
+    auto unique_inverse(const xexpression<E>& e)
+    {
+        std::vector<std::size_t> inverse;
+        auto values = detail::sorted_unique(e.derived_cast(), nullptr, &inverse);
+        return std::make_tuple(detail::to_xtensor(values), detail::to_xtensor(inverse));
+    }
+
+    /**
+     * Returns the sorted distinct elements of the flattened xexpression,
+     * the position of each element of e among them and their number of
+     * occurrences
+     *
+     * @param e xexpression to find the distinct elements of
+     *
+     * @return a tuple of three 1-D arrays, the distinct elements, the
+     *         inverse indices as returned by unique_inverse and the counts
+     *         as returned by unique_counts
+     */
+    template <class E>
+    auto unique_inverse_counts(const xexpression<E>& e)
+    {
+        std::vector<std::size_t> inverse;
+        std::vector<std::size_t> counts;
+        auto values = detail::sorted_unique(e.derived_cast(), &counts, &inverse);
+        return std::make_tuple(detail::to_xtensor(values), detail::to_xtensor(inverse), detail::to_xtensor(counts));
+    }
+
+    /**
+     * Finds the positions where elements should be inserted in a sorted
+     * array to keep it sorted
+     * Each query is searched with a branchless binary search, and the
+     * queries are processed in batches whose searches are interleaved.
+     *
+     * @param a 1-D xexpression sorted in increasing order
+     * @param v values to insert
+     * @param side search_side::left (default) to return the first suitable
+     *        position, search_side::right to return the last one
+     *
+     * @return array of the shape of v holding the positions
+     */
+    template <class E1, class E2>
+    auto searchsorted(const xexpression<E1>& a, const xexpression<E2>& v, search_side side = search_side::left)
+    {
+        auto&& av = eval(a.derived_cast());
+        auto&& vv = eval(v.derived_cast());
+        using query_type = typename std::decay_t<decltype(vv)>::value_type;
+        using result_type = typename detail::argsort_result_type<std::decay_t<decltype(vv)>>::type;
+
+        if (av.dimension() != 1)
+        {
+            throw std::runtime_error("searchsorted requires a 1-D sorted array");
+        }
+
+        result_type result = result_type::from_shape(vv.shape());
+        std::size_t n = av.size();
+        if (n == 0)
+        {
+            std::fill(result.begin(), result.end(), std::size_t(0));
+            return result;
+        }
+
+        // contiguous copy of a if it is strided
+        auto data = av.raw_data() + av.raw_data_offset();
+        std::vector<typename std::decay_t<decltype(av)>::value_type> copy;
+        if (n > 1 && av.strides()[0] != 1)
+        {
+            copy.assign(av.cbegin(), av.cend());
+            data = copy.data();
+        }
+
+        constexpr std::size_t batch_size = detail::searchsorted_batch_size;
+        query_type queries[batch_size];
+        std::size_t res[batch_size];
+        auto query_it = vv.cbegin();
+        auto res_it = result.begin();
+        for (std::size_t remaining = vv.size(); remaining != 0;)
+        {
+            std::size_t m = std::min(batch_size, remaining);
+            for (std::size_t j = 0; j < m; ++j, ++query_it)
+            {
+                queries[j] = *query_it;
+            }
+            detail::searchsorted_batch(data, n, queries, m, res, side);
+            res_it = std::copy(res, res + m, res_it);
+            remaining -= m;
+        }
+        return result;
+    }
+
+    /**
+     * Returns the sorted distinct elements found in both xexpressions
+     * The distinct elements of both flattened xexpressions are merged
+     * in linear time.
+     *
+     * @param a first xexpression
+     * @param b second xexpression
+     *
+     * @return 1-D array of the common distinct elements
+     */
+    template <class E1, class E2>
+    auto intersect1d(const xexpression<E1>& a, const xexpression<E2>& b)
+    {
+        auto ua = detail::sorted_unique(a.derived_cast(), nullptr, nullptr);
+        auto ub = detail::sorted_unique(b.derived_cast(), nullptr, nullptr);
+        std::vector<std::common_type_t<typename E1::value_type, typename E2::value_type>> res;
+        std::set_intersection(ua.cbegin(), ua.cend(), ub.cbegin(), ub.cend(), std::back_inserter(res));
+        return detail::to_xtensor(res);
+    }
+
+    /**
+     * Returns the sorted distinct elements of a that are not in b
+     *
+     * @param a first xexpression
+     * @param b second xexpression
+     *
+     * @return 1-D array of the distinct elements of a missing from b
+     */
+    template <class E1, class E2>
+    auto setdiff1d(const xexpression<E1>& a, const xexpression<E2>& b)
+    {
+        auto ua = detail::sorted_unique(a.derived_cast(), nullptr, nullptr);
+        auto ub = detail::sorted_unique(b.derived_cast(), nullptr, nullptr);
+        std::vector<typename E1::value_type> res;
+        std::set_difference(ua.cbegin(), ua.cend(), ub.cbegin(), ub.cend(), std::back_inserter(res));
+        return detail::to_xtensor(res);
+    }
 }
 
 #endif
@@ -42,6 +42,26 @@
 #endif
 #endif
 
+#ifndef XTENSOR_PARALLEL_GRAIN_SIZE
+#define XTENSOR_PARALLEL_GRAIN_SIZE 32768
+#endif
+
+#ifndef XTENSOR_STREAMING_STORE_THRESHOLD
+#define XTENSOR_STREAMING_STORE_THRESHOLD 33554432
+#endif
+
+#ifndef XTENSOR_RADIX_SORT_THRESHOLD
+#define XTENSOR_RADIX_SORT_THRESHOLD 1024
+#endif
+
+#ifndef XTENSOR_L1_CACHE_SIZE
+#define XTENSOR_L1_CACHE_SIZE 32768
+#endif
+
+#ifndef XTENSOR_L2_CACHE_SIZE
+#define XTENSOR_L2_CACHE_SIZE 262144
+#endif
+
 #ifndef DEFAULT_LAYOUT
 #define DEFAULT_LAYOUT layout_type::row_major
 #endif
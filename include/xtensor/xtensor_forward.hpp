@@ -199,11 +199,24 @@ namespace xt
         struct lazy : base
         {
         };
-        /*
-        struct cached
+        struct parallel : base
+        {
+        };
+        /**
+         * Keeps the reduced axes in the result of a reduction, with
+         * a size of 1. The reduction is evaluated with the strategy ES.
+         */
+        template <class ES = lazy>
+        struct keep_dims : ES
+        {
+        };
+        /**
+         * Returns a lazy expression that evaluates the whole reduction
+         * the first time one of its elements is accessed.
+         */
+        struct cached : base
         {
         };
-        */
     }
 }
 
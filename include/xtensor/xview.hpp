@@ -299,11 +299,19 @@ namespace xt
         void to_begin();
         void to_end(layout_type);
 
+        template <class T>
+        std::enable_if_t<detail::has_simd_step<substepper_type, T>::value, T> step_simd(size_type dim);
+        bool has_linear_step(size_type dim) const;
+        template <class B = bool>
+        std::enable_if_t<detail::has_equivalent_step<substepper_type>::value, B>
+        is_equivalent_step(size_type dim1, size_type n1, size_type dim2, size_type n2) const;
+
         bool equal(const xview_stepper& rhs) const;
 
     private:
 
         bool is_newaxis_slice(size_type index) const noexcept;
+        size_type underlying_step(size_type dim, size_type n, size_type& index) const;
         void to_end_impl();
 
         template <class F>
@@ -377,6 +385,7 @@ namespace xt
     inline auto xview<CT, S...>::operator=(const xview& rhs) -> self_type&
     {
         temporary_type tmp(rhs);
+        detail::record_temporary(tmp.size() * sizeof(typename temporary_type::value_type));
         return this->assign_temporary(std::move(tmp));
     }
 
@@ -983,6 +992,55 @@ namespace xt
         to_end_impl();
     }
 
+    template <bool is_const, class CT, class... S>
+    template <class T>
+    inline auto xview_stepper<is_const, CT, S...>::step_simd(size_type dim)
+        -> std::enable_if_t<detail::has_simd_step<substepper_type, T>::value, T>
+    {
+        if (dim >= m_offset)
+        {
+            size_type index = integral_skip<S...>(dim);
+            if (!is_newaxis_slice(index))
+            {
+                index -= newaxis_count_before<S...>(index);
+                return m_it.template step_simd<T>(index);
+            }
+        }
+        return xsimd::set_simd<value_type, typename T::value_type>(*m_it);
+    }
+
+    template <bool is_const, class CT, class... S>
+    inline bool xview_stepper<is_const, CT, S...>::has_linear_step(size_type dim) const
+    {
+        if (dim < m_offset)
+        {
+            return true;
+        }
+        size_type index = integral_skip<S...>(dim);
+        if (is_newaxis_slice(index))
+        {
+            return true;
+        }
+        auto func = [](const auto& s) noexcept { return step_size(s); };
+        size_type step_size = index < sizeof...(S) ?
+            apply<size_type>(index, func, p_view->slices()) : 1;
+        index -= newaxis_count_before<S...>(index);
+        return step_size == 1 && m_it.has_linear_step(index);
+    }
+
+    template <bool is_const, class CT, class... S>
+    template <class B>
+    inline auto xview_stepper<is_const, CT, S...>::is_equivalent_step(size_type dim1, size_type n1,
+                                                                      size_type dim2, size_type n2) const
+        -> std::enable_if_t<detail::has_equivalent_step<substepper_type>::value, B>
+    {
+        size_type index1 = 0;
+        size_type index2 = 0;
+        n1 = underlying_step(dim1, n1, index1);
+        n2 = underlying_step(dim2, n2, index2);
+        return m_it.is_equivalent_step(index1, n1, index2, n2);
+    }
+
     template <bool is_const, class CT, class... S>
     inline bool xview_stepper<is_const, CT, S...>::equal(const xview_stepper& rhs) const
     {
@@ -996,6 +1054,26 @@ namespace xt
         return newaxis_count_before<S...>(index + 1) != newaxis_count_before<S...>(index);
     }
 
+    // Maps n steps along the dimension dim of the view to steps along the
+    // dimension index of the underlying expression; returns 0 if the
+    // underlying stepper does not move.
+    template <bool is_const, class CT, class... S>
+    inline auto xview_stepper<is_const, CT, S...>::underlying_step(size_type dim, size_type n, size_type& index) const -> size_type
+    {
+        if (dim >= m_offset)
+        {
+            size_type i = integral_skip<S...>(dim);
+            if (!is_newaxis_slice(i))
+            {
+                auto func = [](const auto& s) noexcept { return step_size(s); };
+                size_type step_size = i < sizeof...(S) ? apply<size_type>(i, func, p_view->slices()) : 1;
+                index = i - newaxis_count_before<S...>(i);
+                return step_size * n;
+            }
+        }
+        return 0;
+    }
+
     template <bool is_const, class CT, class... S>
     inline void xview_stepper<is_const, CT, S...>::to_end_impl()
     {
@@ -189,4 +189,103 @@ namespace xt
                                    {  9, 90, 990}};
         EXPECT_TRUE(allclose(expected_1, res_1));
     }
-}
\ No newline at end of file
+
+    TEST(xaccumulator, axis_of_size_one)
+    {
+        xtensor<double, 3> a = {{{1., 2.}}, {{3., 4.}}};
+        xtensor<double, 3> res = cumsum(a, 1);
+        EXPECT_EQ(a, res);
+    }
+
+    TEST(xaccumulator, parallel)
+    {
+        xarray<double> a = xt::arange(5 * 4 * 3);
+        a.reshape({5, 4, 3});
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            EXPECT_EQ(cumsum(a, axis), cumsum(a, axis, evaluation_strategy::parallel()));
+            EXPECT_EQ(cumprod(a, axis), cumprod(a, axis, evaluation_strategy::parallel()));
+        }
+        EXPECT_EQ(cumsum(a), cumsum(a, evaluation_strategy::parallel()));
+
+        std::size_t n = 3 * XTENSOR_PARALLEL_GRAIN_SIZE + 7;
+        xtensor<long long, 1> ones = xt::ones<long long>({n});
+        xtensor<long long, 1> expected = xt::arange<long long>(1, static_cast<long long>(n) + 1);
+        EXPECT_EQ(expected, cumsum(ones, 0, evaluation_strategy::parallel()));
+        EXPECT_EQ(expected, cumsum(ones, evaluation_strategy::parallel()));
+
+        xtensor<long long, 2> twice = xt::ones<long long>({std::size_t(2), n});
+        auto res = cumsum(twice, 1, evaluation_strategy::parallel());
+        EXPECT_EQ(static_cast<long long>(n), res(1, n - 1));
+    }
+
+    struct running_max
+    {
+        using result_type = double;
+
+        double operator()(double lhs, double rhs) const
+        {
+            return lhs < rhs ? rhs : lhs;
+        }
+    };
+
+    template <>
+    struct is_associative<running_max> : std::true_type
+    {
+    };
+
+    TEST(xaccumulator, associative_functor)
+    {
+        std::size_t n = 3 * XTENSOR_PARALLEL_GRAIN_SIZE;
+        xtensor<double, 1> a = xt::arange<double>(static_cast<double>(n));
+        a(10) = static_cast<double>(2 * n);
+        xtensor<double, 1> res = accumulate(running_max(), a, evaluation_strategy::parallel());
+        EXPECT_EQ(9., res(9));
+        EXPECT_EQ(static_cast<double>(2 * n), res(n - 1));
+        EXPECT_EQ(accumulate(running_max(), a), res);
+    }
+
+    TEST(xaccumulator, lazy)
+    {
+        xarray<double> a = xt::arange(5 * 4 * 3);
+        a.reshape({5, 4, 3});
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            xarray<double> expected = cumsum(a, axis);
+            auto lazy = cumsum(a, axis, evaluation_strategy::lazy());
+            EXPECT_EQ(expected.shape(), lazy.shape());
+            EXPECT_EQ(expected(4, 3, 2), lazy(4, 3, 2));
+            EXPECT_EQ(expected(2, 1, 1), lazy(2, 1, 1));
+
+            xarray<double> res = lazy;
+            EXPECT_EQ(expected, res);
+
+            xarray<double> centered = a - cumsum(a, axis, evaluation_strategy::lazy());
+            EXPECT_EQ(xarray<double>(a - expected), centered);
+
+            xarray<double, layout_type::column_major> col = lazy;
+            EXPECT_EQ(expected, col);
+        }
+
+        xarray<double> b = {1., 2., 3.};
+        xarray<double> broadcast = cumprod(b, 0, evaluation_strategy::lazy()) + a;
+        EXPECT_EQ(6. + a(4, 3, 2), broadcast(4, 3, 2));
+
+        // size 1 lane dimension broadcast against a larger shape
+        xarray<double> c = {{1.}, {2.}, {3.}};
+        xarray<double> lane_broadcast = cumsum(c, 0, evaluation_strategy::lazy()) + zeros<double>({3, 4});
+        xarray<double> ex_lane = {{1., 1., 1., 1.}, {3., 3., 3., 3.}, {6., 6., 6., 6.}};
+        EXPECT_EQ(ex_lane, lane_broadcast);
+
+        // size 1 accumulated axis broadcast against a larger shape
+        xarray<double> d = {{1., 2., 3.}};
+        xarray<double> axis_broadcast = cumsum(d, 0, evaluation_strategy::lazy()) + zeros<double>({4, 3});
+        xarray<double> ex_axis = {{1., 2., 3.}, {1., 2., 3.}, {1., 2., 3.}, {1., 2., 3.}};
+        EXPECT_EQ(ex_axis, axis_broadcast);
+
+        auto lazy = cumsum(a, 1, evaluation_strategy::lazy());
+        xarray<double> expected = cumsum(a, 1);
+        EXPECT_TRUE(std::equal(lazy.cbegin(), lazy.cend(), expected.cbegin()));
+        EXPECT_TRUE(std::equal(lazy.crbegin(), lazy.crend(), expected.crbegin()));
+    }
+}
@@ -0,0 +1,80 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xassign_stats.hpp"
+#include "xtensor/xnoalias.hpp"
+#include "xtensor/xtensor.hpp"
+#include "xtensor/xview.hpp"
+
+namespace xt
+{
+#ifdef XTENSOR_ENABLE_ASSIGN_STATS
+
+    TEST(xassign_stats, trivial)
+    {
+        xtensor<double, 2> a = {{1., 2., 3.}, {4., 5., 6.}};
+        xtensor<double, 2> b = a;
+        xtensor<double, 2> res = xtensor<double, 2>::from_shape({2, 3});
+        reset_assign_stats();
+        noalias(res) = a + b;
+        xassign_stats stats = get_assign_stats();
+        const xassign_path_stats& trivial = stats[assign_path::simd_trivial].count != 0 ?
+            stats[assign_path::simd_trivial] : stats[assign_path::scalar_trivial];
+        EXPECT_EQ(1u, trivial.count);
+        EXPECT_EQ(6u, trivial.elements);
+        EXPECT_EQ(6u * sizeof(double), trivial.bytes);
+        EXPECT_EQ(0u, stats[assign_path::stepper].count);
+        EXPECT_EQ(0u, stats.temporaries);
+    }
+
+    TEST(xassign_stats, stepper)
+    {
+        xtensor<double, 2> a = {{1., 2., 3.}, {4., 5., 6.}};
+        xtensor<double, 1> res = xtensor<double, 1>::from_shape({3});
+        reset_assign_stats();
+        noalias(res) = view(a, 1, all()) + 1.;
+        xassign_stats stats = get_assign_stats();
+        EXPECT_EQ(1u, stats[assign_path::stepper].count);
+        EXPECT_EQ(3u, stats[assign_path::stepper].elements);
+        EXPECT_EQ(0u, stats[assign_path::simd_trivial].count);
+        EXPECT_EQ(0u, stats[assign_path::scalar_trivial].count);
+    }
+
+    TEST(xassign_stats, temporary)
+    {
+        xarray<double> a = {1., 2., 3.};
+        xarray<double> b = {{1., 2., 3.}, {4., 5., 6.}};
+        reset_assign_stats();
+        a += b;
+        xassign_stats stats = get_assign_stats();
+        EXPECT_EQ(1u, stats.temporaries);
+        EXPECT_EQ(6u * sizeof(double), stats.temporary_bytes);
+
+        reset_assign_stats();
+        stats = get_assign_stats();
+        EXPECT_EQ(0u, stats.temporaries);
+        EXPECT_EQ(0u, stats[assign_path::stepper].count);
+        EXPECT_EQ(0., stats[assign_path::stepper].seconds);
+    }
+
+#else
+
+    TEST(xassign_stats, disabled)
+    {
+        xtensor<double, 1> a = {1., 2., 3.};
+        xtensor<double, 1> res = a + a;
+        xassign_stats stats = get_assign_stats();
+        EXPECT_EQ(0u, stats[assign_path::simd_trivial].count);
+        EXPECT_EQ(0u, stats[assign_path::scalar_trivial].count);
+        EXPECT_EQ(0u, stats.temporaries);
+    }
+
+#endif
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+// This file is built in the test_xtensor_stream target, with a small
+// XTENSOR_STREAMING_STORE_THRESHOLD so that regular assignments of
+// moderate size take the streaming store path of trivial_assigner.
+
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "xtensor/xadapt.hpp"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xtensor.hpp"
+
+namespace xt
+{
+    static_assert(XTENSOR_STREAMING_STORE_THRESHOLD <= 4096, "test_xassign_stream requires a small streaming store threshold");
+
+    namespace
+    {
+        constexpr std::size_t stream_size = 10003;
+
+        xtensor<double, 1> make_stream_input()
+        {
+            xtensor<double, 1> a = xtensor<double, 1>::from_shape({stream_size});
+            for (std::size_t i = 0; i < stream_size; ++i)
+            {
+                a(i) = double(i);
+            }
+            return a;
+        }
+    }
+
+    TEST(xassign_stream, aligned_destination)
+    {
+        xtensor<double, 1> a = make_stream_input();
+        xtensor<double, 1> res = xtensor<double, 1>::from_shape({stream_size});
+        res = a + 1.;
+        for (std::size_t i = 0; i < stream_size; ++i)
+        {
+            EXPECT_EQ(a(i) + 1., res(i));
+        }
+
+        xarray<double> ares = xarray<double>::from_shape({stream_size});
+        ares = 2. * a;
+        for (std::size_t i = 0; i < stream_size; ++i)
+        {
+            EXPECT_EQ(2. * a(i), ares(i));
+        }
+    }
+
+    TEST(xassign_stream, unaligned_destination)
+    {
+        xtensor<double, 1> a = make_stream_input();
+        std::vector<double> buffer(stream_size + 3, -1.);
+        for (std::size_t shift = 1; shift < 3; ++shift)
+        {
+            std::vector<std::size_t> shape = {stream_size};
+            auto res = adapt(buffer.data() + shift, stream_size, no_ownership(), shape);
+            res = a + 1.;
+            for (std::size_t i = 0; i < stream_size; ++i)
+            {
+                EXPECT_EQ(a(i) + 1., res(i));
+            }
+        }
+        EXPECT_EQ(-1., buffer[0]);
+
+        xtensor<float, 1> fres = xtensor<float, 1>::from_shape({stream_size});
+        fres = 2. * a;
+        for (std::size_t i = 0; i < stream_size; ++i)
+        {
+            EXPECT_EQ(float(2. * a(i)), fres(i));
+        }
+    }
+}
@@ -8,6 +8,7 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <cstddef>
 #include "xtensor/xarray.hpp"
 #include "xtensor/xtensor.hpp"
@@ -464,4 +465,45 @@ namespace xt
         auto actual = (cast<double>(a) / 2)(0, 0);
         EXPECT_EQ(ref, actual);
     }
+
+#ifdef XTENSOR_ENABLE_FMA_CONTRACTION
+    TEST(operation, fma_contraction)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+        xarray<double> b = {{0.5, 1.5, 2.5}, {3.5, 4.5, 5.5}};
+        xarray<double> c = {1., -2., 3.};
+
+        auto f1 = a * b + c;
+        auto f2 = c + a * b;
+        auto f3 = a * b - c;
+        auto f4 = c - a * b;
+        using f1_type = decltype(f1);
+        using f4_type = decltype(f4);
+        EXPECT_TRUE((std::is_same<f1_type::functor_type, detail::multiply_plus<double>>::value));
+        EXPECT_TRUE((std::is_same<decltype(f2)::functor_type, detail::multiply_plus<double>>::value));
+        EXPECT_TRUE((std::is_same<decltype(f3)::functor_type, detail::multiply_minus<double>>::value));
+        EXPECT_TRUE((std::is_same<f4_type::functor_type, detail::negate_multiply_plus<double>>::value));
+
+        xarray<double> r1 = f1;
+        xarray<double> r2 = f2;
+        xarray<double> r3 = f3;
+        xarray<double> r4 = f4;
+        xarray<double> r5 = 2. * a + 1.;
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                EXPECT_EQ(std::fma(a(i, j), b(i, j), c(j)), r1(i, j));
+                EXPECT_EQ(std::fma(a(i, j), b(i, j), c(j)), r2(i, j));
+                EXPECT_EQ(std::fma(a(i, j), b(i, j), -c(j)), r3(i, j));
+                EXPECT_EQ(std::fma(-a(i, j), b(i, j), c(j)), r4(i, j));
+                EXPECT_EQ(std::fma(2., a(i, j), 1.), r5(i, j));
+            }
+        }
+
+        xarray<int> ia = {1, 2, 3};
+        auto fi = ia * ia + ia;
+        EXPECT_TRUE((std::is_same<decltype(fi)::functor_type, detail::plus<int>>::value));
+    }
+#endif
 }
@@ -64,6 +64,35 @@ namespace xt
         ASSERT_FALSE(res(1, 1).has_value());
     }
 
+    TEST(xoptional, assign)
+    {
+        xarray_optional<double> a
+            {{ 1.0 ,       2.0         },
+             { 3.0 , xtl::missing<double>() }};
+
+        xarray_optional<double> b
+            {{ 4.0 , xtl::missing<double>() },
+             { 5.0 ,       6.0         }};
+
+        xarray_optional<double> res = a;
+        res = a + b;
+        ASSERT_EQ(res(0, 0).value(), 5.0);
+        ASSERT_EQ(res(1, 0).value(), 8.0);
+        ASSERT_FALSE(res(0, 1).has_value());
+        ASSERT_FALSE(res(1, 1).has_value());
+
+        res = a;
+        res = res + b;
+        ASSERT_EQ(res(0, 0).value(), 5.0);
+        ASSERT_FALSE(res(0, 1).has_value());
+
+        xtensor_optional<double, 2> tres = a;
+        tres = a * b;
+        ASSERT_EQ(tres(0, 0).value(), 4.0);
+        ASSERT_EQ(tres(1, 0).value(), 15.0);
+        ASSERT_FALSE(tres(0, 1).has_value());
+    }
+
     TEST(xoptional, xio)
     {
         std::ostringstream oss;
@@ -0,0 +1,153 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xparallel.hpp"
+#include "xtensor/xtensor.hpp"
+
+namespace xt
+{
+    class num_threads_guard
+    {
+    public:
+
+        explicit num_threads_guard(std::size_t n)
+            : m_old(get_num_threads())
+        {
+            set_num_threads(n);
+        }
+
+        ~num_threads_guard()
+        {
+            set_num_threads(m_old);
+        }
+
+    private:
+
+        std::size_t m_old;
+    };
+
+    TEST(xparallel, num_threads)
+    {
+        num_threads_guard guard(3);
+#ifdef XTENSOR_USE_THREADS
+        EXPECT_EQ(get_num_threads(), 3u);
+        set_num_threads(0);
+        EXPECT_GE(get_num_threads(), 1u);
+#else
+        EXPECT_EQ(get_num_threads(), 1u);
+#endif
+    }
+
+    TEST(xparallel, parallel_for)
+    {
+        num_threads_guard guard(4);
+        std::vector<int> visited(1003, 0);
+        detail::parallel_for(0, visited.size(), 10, [&visited](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                ++visited[i];
+            }
+        });
+        for (auto v : visited)
+        {
+            EXPECT_EQ(1, v);
+        }
+
+        std::atomic<std::size_t> calls(0);
+        detail::parallel_for(5, 5, 1, [&calls](std::size_t, std::size_t) { ++calls; });
+        EXPECT_EQ(0u, calls.load());
+    }
+
+    TEST(xparallel, chunks)
+    {
+        num_threads_guard guard(4);
+        detail::xchunks small = detail::split_chunks(1003, 1000);
+        EXPECT_EQ(1u, small.count);
+        EXPECT_EQ(1003u, small.last(0));
+
+        detail::xchunks chunks = detail::split_chunks(1003, 10);
+#ifdef XTENSOR_USE_THREADS
+        EXPECT_EQ(4u, chunks.count);
+        EXPECT_EQ(251u, chunks.length);
+#else
+        EXPECT_EQ(1u, chunks.count);
+#endif
+        std::vector<int> visited(1003, 0);
+        detail::parallel_for_chunks(chunks, [&visited, &chunks](std::size_t c, std::size_t first, std::size_t last) {
+            EXPECT_EQ(chunks.first(c), first);
+            EXPECT_EQ(chunks.last(c), last);
+            for (std::size_t i = first; i < last; ++i)
+            {
+                ++visited[i];
+            }
+        });
+        for (auto v : visited)
+        {
+            EXPECT_EQ(1, v);
+        }
+    }
+
+    TEST(xparallel, exception)
+    {
+        num_threads_guard guard(4);
+        auto f = [](std::size_t first, std::size_t) {
+            if (first != 0)
+            {
+                throw std::runtime_error("chunk failure");
+            }
+        };
+        bool thrown = false;
+        try
+        {
+            detail::parallel_for(0, 100, 1, f);
+        }
+        catch (std::runtime_error&)
+        {
+            thrown = true;
+        }
+#ifdef XTENSOR_USE_THREADS
+        EXPECT_TRUE(thrown);
+#else
+        EXPECT_FALSE(thrown);
+#endif
+    }
+
+    TEST(xparallel, trivial_assign)
+    {
+        std::size_t n = 4 * XTENSOR_PARALLEL_GRAIN_SIZE + 7;
+        xarray<double> a = arange<double>(double(n));
+        xarray<double> b = 2. * a;
+
+        xarray<double> res_serial, res_parallel;
+        {
+            num_threads_guard guard(1);
+            res_serial = a + b;
+        }
+        {
+            num_threads_guard guard(4);
+            res_parallel = a + b;
+        }
+        EXPECT_EQ(res_serial, res_parallel);
+        EXPECT_EQ(3. * double(n - 1), res_parallel(n - 1));
+
+        xtensor<int, 1> ires;
+        {
+            num_threads_guard guard(4);
+            ires = a;
+        }
+        EXPECT_EQ(int(n - 1), ires(n - 1));
+        EXPECT_EQ(int(n / 2), ires(n / 2));
+    }
+}
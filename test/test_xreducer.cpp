@@ -6,12 +6,16 @@
 * The full license is in the file LICENSE, distributed with this software. *
 ****************************************************************************/
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "xtensor/xarray.hpp"
 #include "xtensor/xtensor.hpp"
 #include "xtensor/xbuilder.hpp"
 #include "xtensor/xmath.hpp"
 #include "xtensor/xreducer.hpp"
+#include "xtensor/xstrided_view.hpp"
+#include "xtensor/xview.hpp"
 
 namespace xt
 {
@@ -241,6 +245,282 @@ namespace xt
         EXPECT_EQ(a_lz, a_gd);
     }
 
+    TEST(xreducer, immediate_strided)
+    {
+        xarray<double> a = xt::arange(4 * 3 * 6 * 2 * 7);
+        a.resize({4, 3, 6, 2, 7});
+
+        auto v = xt::view(a, xt::range(1, 3), xt::all(), xt::range(0, 6, 2));
+        EXPECT_EQ(xarray<double>(sum(v, {1, 3})), sum(v, {1, 3}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(v, {0, 2, 4})), sum(v, {0, 2, 4}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(v)), sum(v, evaluation_strategy::immediate()));
+
+        auto c = xt::view(a, xt::range(1, 3));
+        EXPECT_EQ(xarray<double>(sum(c, {1, 3})), sum(c, {1, 3}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(c, {4})), sum(c, {4}, evaluation_strategy::immediate()));
+
+        auto t = xt::transpose(a);
+        EXPECT_EQ(xarray<double>(sum(t, {0, 2})), sum(t, {0, 2}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(t, {3})), sum(t, {3}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(amax(t, {1, 4})), amax(t, {1, 4}, evaluation_strategy::immediate()));
+
+        xtensor<double, 3> out;
+        sum(t, {1, 3}, out, evaluation_strategy::immediate());
+        EXPECT_EQ(xarray<double>(sum(t, {1, 3})), out);
+
+        EXPECT_EQ(xarray<double>(sum(a + 1., {1, 3})), sum(a + 1., {1, 3}, evaluation_strategy::immediate()));
+    }
+
+    TEST(xreducer, immediate_simd)
+    {
+        xarray<double> a = xt::arange(5 * 37 * 11) % 17 - 8.;
+        a.resize({5, 37, 11});
+        xarray<int> ia = xt::cast<int>(a);
+
+        EXPECT_EQ(xarray<double>(sum(a, {2})), sum(a, {2}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(a, {1})), sum(a, {1}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(a, {1, 2})), sum(a, {1, 2}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(sum(a)), sum(a, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<long long>(sum(ia, {2})), sum(ia, {2}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<long long>(sum(ia, {0})), sum(ia, {0}, evaluation_strategy::immediate()));
+
+        EXPECT_EQ(xarray<double>(amax(a, {1, 2})), amax(a, {1, 2}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(amin(a, {0})), amin(a, {0}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<int>(amax(ia, {2})), amax(ia, {2}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<int>(amin(ia)), amin(ia, evaluation_strategy::immediate()));
+
+        xarray<double> b = xt::arange(3 * 40) % 3 - 1.;
+        b.resize({3, 40});
+        b = b * 0.5 + 1.;
+        EXPECT_EQ(xarray<double>(prod(b, {1})), prod(b, {1}, evaluation_strategy::immediate()));
+        EXPECT_EQ(xarray<double>(prod(b, {0})), prod(b, {0}, evaluation_strategy::immediate()));
+    }
+
+    TEST(xreducer, parallel)
+    {
+        xarray<double> a = xt::arange(4 * 3 * 6 * 2 * 7);
+        a.resize({4, 3, 6, 2, 7});
+
+        EXPECT_EQ(xarray<double>(sum(a)), sum(a, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(sum(a, {1})), sum(a, {1}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(sum(a, {0, 2})), sum(a, {0, 2}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(sum(a, {1, 2, 3})), sum(a, {1, 2, 3}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(sum(a, {0, 1, 2, 3})), sum(a, {0, 1, 2, 3}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(amax(a, {4})), amax(a, {4}, evaluation_strategy::parallel()));
+
+        xarray<double, layout_type::column_major> b = a;
+        EXPECT_EQ(xarray<double>(sum(b, {1, 3})), sum(b, {1, 3}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(sum(a + 1., {2})), sum(a + 1., {2}, evaluation_strategy::parallel()));
+
+        xarray<double> c = xt::arange(1 << 17);
+        c.resize({2, 1 << 16});
+        EXPECT_EQ(xarray<double>(sum(c, {1})), sum(c, {1}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(sum(c, {0})), sum(c, {0}, evaluation_strategy::parallel()));
+
+        // Blocks starting and ending in the middle of the contiguous runs
+        xarray<double> d = xt::arange(3 * 1000 * 37);
+        d.resize({3, 1000, 37});
+        EXPECT_EQ(xarray<double>(sum(d, {1, 2})), sum(d, {1, 2}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(amax(d, {1, 2})), amax(d, {1, 2}, evaluation_strategy::parallel()));
+        xarray<double> e = xt::arange(100 * 200 * 37);
+        e.resize({100, 200, 37});
+        EXPECT_EQ(xarray<double>(sum(e, {0})), sum(e, {0}, evaluation_strategy::parallel()));
+        EXPECT_EQ(xarray<double>(amin(e, {0})), amin(e, {0}, evaluation_strategy::parallel()));
+    }
+
+    TEST(xreducer, fsum)
+    {
+        std::size_t n = 1000000;
+        xarray<float> a = xarray<float>::from_shape({n});
+        std::fill(a.begin(), a.end(), 0.1f);
+        double expected = double(n) * double(0.1f);
+
+        float pairwise = fsum(a)();
+        float kahan = fsum(a, summation::kahan())();
+        EXPECT_NEAR(expected, double(pairwise), expected * 1e-6);
+        EXPECT_NEAR(expected, double(kahan), expected * 1e-7);
+
+        xarray<double> b = xt::arange(4 * 3 * 6 * 2 * 7);
+        b.resize({4, 3, 6, 2, 7});
+        EXPECT_EQ(xarray<double>(sum(b, {1})), fsum(b, {1}));
+        EXPECT_EQ(xarray<double>(sum(b, {0, 2})), fsum(b, {0, 2}, summation::kahan()));
+        EXPECT_EQ(xarray<double>(sum(b, {2, 4})), fsum(b, {2, 4}));
+        EXPECT_EQ(xarray<double>(sum(b, {3, 4})), fsum(b + 0., {3, 4}, summation::kahan()));
+
+        xarray<double> c = {1e100, 1., -1e100};
+        EXPECT_EQ(1., fsum(c, summation::kahan())());
+    }
+
+    TEST(xreducer, fsum_strided_axis)
+    {
+        // the reduced axis is strided, the kept one is contiguous
+        std::size_t n = 20000;
+        xarray<float> a = xarray<float>::from_shape({n, 300});
+        std::fill(a.begin(), a.end(), 0.1f);
+        a(3, 7) = 5.f;
+        xarray<float> at = transpose(a);
+        xarray<float> pairwise = fsum(a, {0});
+        xarray<float> kahan = fsum(a, {0}, summation::kahan());
+        xarray<float> ex_pairwise = fsum(at, {1});
+        xarray<float> ex_kahan = fsum(at, {1}, summation::kahan());
+        double tol = double(n) * 1e-6;
+        for (std::size_t i = 0; i < 300; ++i)
+        {
+            EXPECT_NEAR(double(ex_pairwise(i)), double(pairwise(i)), tol);
+            EXPECT_NEAR(double(ex_kahan(i)), double(kahan(i)), tol);
+        }
+
+        xarray<double> b = xt::arange(4 * 3 * 6 * 2 * 7);
+        b.resize({4, 3, 6, 2, 7});
+        EXPECT_EQ(xarray<double>(sum(b, {0, 3})), fsum(b, {0, 3}));
+        EXPECT_EQ(xarray<double>(sum(b, {1, 2})), fsum(b, {1, 2}, summation::kahan()));
+
+        xarray<double> c = {{1e100, 1e100}, {1., 2.}, {-1e100, -1e100}};
+        xarray<double> ex_c = {1., 2.};
+        EXPECT_EQ(ex_c, fsum(c, {0}, summation::kahan()));
+    }
+
+    TEST(xreducer, keep_dims)
+    {
+        xarray<double> a = xt::arange(4 * 3 * 6 * 2 * 7);
+        a.resize({4, 3, 6, 2, 7});
+        xarray<double> expected = sum(a, {1, 3});
+        expected.reshape({4, 1, 6, 1, 7});
+
+        auto lazy = sum(a, {1, 3}, evaluation_strategy::keep_dims<>());
+        EXPECT_EQ(expected.shape(), lazy.shape());
+        EXPECT_EQ(expected, lazy);
+        EXPECT_EQ(expected(2, 0, 3, 0, 5), lazy(2, 0, 3, 0, 5));
+        EXPECT_EQ(expected, sum(a, {1, 3}, evaluation_strategy::keep_dims<evaluation_strategy::immediate>()));
+        EXPECT_EQ(expected, sum(a, {1, 3}, evaluation_strategy::keep_dims<evaluation_strategy::parallel>()));
+
+        xarray<double> centered = a - sum(a, {1, 3}, evaluation_strategy::keep_dims<>());
+        EXPECT_EQ(a(2, 1, 3, 1, 5) - expected(2, 0, 3, 0, 5), centered(2, 1, 3, 1, 5));
+
+        xtensor<double, 2> b = {{1., 2., 3.}, {4., 5., 6.}};
+        auto s = sum(b, {0}, evaluation_strategy::keep_dims<>());
+        std::array<std::size_t, 2> shape = {1, 3};
+        EXPECT_EQ(shape, s.shape());
+        EXPECT_EQ(9., s(0, 2));
+    }
+
+    TEST(xreducer, output)
+    {
+        xarray<double> a = xt::arange(4 * 3 * 6 * 2 * 7);
+        a.resize({4, 3, 6, 2, 7});
+        xarray<double> expected = sum(a, {1, 3});
+
+        xtensor<double, 3> out;
+        sum(a, {1, 3}, out);
+        EXPECT_EQ(expected, out);
+
+        const double* data = out.raw_data();
+        sum(a + 1., {1, 3}, out);
+        EXPECT_EQ(xarray<double>(expected + 6.), out);
+        sum(a, {1, 3}, out, evaluation_strategy::immediate());
+        EXPECT_EQ(expected, out);
+        sum(a, {1, 3}, out, evaluation_strategy::parallel());
+        EXPECT_EQ(expected, out);
+        EXPECT_EQ(data, out.raw_data());
+
+        xtensor<double, 5> out_kd;
+        sum(a, {1, 3}, out_kd, evaluation_strategy::keep_dims<evaluation_strategy::immediate>());
+        xarray<double> expected_kd = expected;
+        expected_kd.reshape({4, 1, 6, 1, 7});
+        EXPECT_EQ(expected_kd, out_kd);
+        sum(a, {1, 3}, out_kd, evaluation_strategy::keep_dims<evaluation_strategy::parallel>());
+        EXPECT_EQ(expected_kd, out_kd);
+        sum(a, {1, 3}, out_kd, evaluation_strategy::keep_dims<>());
+        EXPECT_EQ(expected_kd, out_kd);
+
+        xarray<int> ai = {{1, 2}, {3, 4}};
+        xarray<long long> out_i;
+        sum(ai, {1}, out_i, evaluation_strategy::immediate());
+        EXPECT_EQ(xarray<long long>({3, 7}), out_i);
+
+        xtensor<double, 2> wrong_rank;
+        EXPECT_THROW(sum(a, {1, 3}, wrong_rank, evaluation_strategy::immediate()), std::runtime_error);
+    }
+
+    TEST(xreducer, cached)
+    {
+        xarray<double> a = xt::arange(4 * 3 * 6 * 2 * 7);
+        a.resize({4, 3, 6, 2, 7});
+        xarray<double> expected = sum(a, {1, 3});
+
+        auto c = sum(a, {1, 3}, evaluation_strategy::cached());
+        EXPECT_EQ(expected.shape(), c.shape());
+        EXPECT_EQ(expected(2, 1, 5), c(2, 1, 5));
+        EXPECT_EQ(expected, c);
+        EXPECT_EQ(expected, c.value());
+        EXPECT_EQ(&c.value(), &c.value());
+
+        xarray<double> centered = a - mean(a, {1, 3}, evaluation_strategy::keep_dims<evaluation_strategy::cached>());
+        xarray<double> centered_lazy = a - mean(a, {1, 3}, evaluation_strategy::keep_dims<>());
+        EXPECT_EQ(centered_lazy, centered);
+
+        xtensor<double, 2> b = {{1., 2., 3.}, {4., 5., 6.}};
+        auto cb = cached(b + 1.);
+        std::array<std::size_t, 2> shape = {2, 3};
+        EXPECT_EQ(shape, cb.shape());
+        EXPECT_EQ(7., cb(1, 2));
+        xtensor<double, 2> res = cb * 2.;
+        EXPECT_EQ(xtensor<double, 2>(2. * (b + 1.)), res);
+
+        xtensor<double, 3> out;
+        sum(a, {1, 3}, out, evaluation_strategy::cached());
+        EXPECT_EQ(expected, out);
+    }
+
+    TEST(xreducer, stats)
+    {
+        xarray<double> a = xt::arange(4 * 3 * 6 * 2 * 7);
+        a.resize({4, 3, 6, 2, 7});
+        a = a * a / 7.;
+
+        xarray<double> m = mean(a, {1, 3});
+        xarray<double> d = a - xt::view(m, xt::all(), xt::newaxis(), xt::all(), xt::newaxis(), xt::all());
+        xarray<double> var_expected = mean(d * d, {1, 3});
+        xarray<double> min_expected = amin(a, {1, 3});
+        xarray<double> max_expected = amax(a, {1, 3});
+
+        auto check = [&](const auto& s) {
+            ASSERT_EQ(m.shape(), s.shape());
+            for (std::size_t i = 0; i < m.size(); ++i)
+            {
+                const auto& st = s.data()[i];
+                EXPECT_EQ(6u, st.count);
+                EXPECT_NEAR(m.data()[i], st.mean, 1e-9 * m.data()[i]);
+                EXPECT_NEAR(var_expected.data()[i], st.variance(), 1e-9 * var_expected.data()[i]);
+                EXPECT_EQ(min_expected.data()[i], st.min);
+                EXPECT_EQ(max_expected.data()[i], st.max);
+            }
+        };
+
+        check(xarray<xstats<double>>(stats(a, {1, 3})));
+        check(stats(a, {1, 3}, evaluation_strategy::immediate()));
+        check(stats(a, {1, 3}, evaluation_strategy::parallel()));
+
+        EXPECT_TRUE(allclose(var_expected, variance(a, {1, 3})));
+        EXPECT_TRUE(allclose(sqrt(var_expected), stddev(a, {1, 3})));
+
+        xarray<int> b = {{1, 2, 3, 4}, {2, 4, 6, 8}};
+        auto sb = stats(b)();
+        EXPECT_EQ(8u, sb.count);
+        EXPECT_DOUBLE_EQ(3.75, sb.mean);
+        EXPECT_DOUBLE_EQ(37.5 / 8., sb.variance());
+        EXPECT_DOUBLE_EQ(37.5 / 7., sb.variance(1));
+        EXPECT_DOUBLE_EQ(37.5, sb.variance(7));
+        EXPECT_TRUE(std::isnan(sb.variance(8)));
+        EXPECT_TRUE(std::isnan(sb.variance(9)));
+        EXPECT_TRUE(std::isnan(sb.stddev(8)));
+        EXPECT_EQ(1., sb.min);
+        EXPECT_EQ(8., sb.max);
+        xarray<double> vb = variance(b, {1});
+        EXPECT_DOUBLE_EQ(1.25, vb(0));
+        EXPECT_DOUBLE_EQ(5., vb(1));
+    }
+
     TEST(xreducer, chaining_reducers)
     {
         xt::xarray<double> a = {{ 1., 2. },
@@ -6,9 +6,17 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "xtensor/xarray.hpp"
 #include "xtensor/xio.hpp"
+#include "xtensor/xmath.hpp"
 #include "xtensor/xinfo.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xrandom.hpp"
@@ -71,6 +79,39 @@ namespace xt
         EXPECT_EQ(ex_3, argmax(a, 1));
     }
 
+    TEST(xsort, argmax_contiguous)
+    {
+        std::size_t n = 3 * XTENSOR_PARALLEL_GRAIN_SIZE + 5;
+        xarray<double> a = xt::random::rand<double>({n});
+        a(7) = -1.;
+        a(n - 3) = -1.;
+        a(2000) = 2.;
+        a(n - 1) = 2.;
+        EXPECT_EQ(7u, argmin(a)());
+        EXPECT_EQ(2000u, argmax(a)());
+        EXPECT_EQ(7u, argmin(a, evaluation_strategy::parallel())());
+        EXPECT_EQ(2000u, argmax(a, evaluation_strategy::parallel())());
+
+        xarray<float> f = xt::random::rand<float>({n});
+        f(n - 2) = 2.f;
+        EXPECT_EQ(n - 2, argmax(f)());
+        EXPECT_EQ(n - 2, argmax(f, evaluation_strategy::parallel())());
+        auto fmin = static_cast<std::size_t>(std::distance(f.cbegin(), std::min_element(f.cbegin(), f.cend())));
+        EXPECT_EQ(fmin, argmin(f)());
+
+        xarray<int> b = xt::random::randint<int>({5, 3000}, -1000, 1000);
+        xarray<std::size_t> ex_min = {0, 0, 0, 0, 0};
+        xarray<std::size_t> ex_max = {0, 0, 0, 0, 0};
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            auto row = view(b, i, xt::all());
+            ex_min(i) = static_cast<std::size_t>(std::distance(row.begin(), std::min_element(row.begin(), row.end())));
+            ex_max(i) = static_cast<std::size_t>(std::distance(row.begin(), std::max_element(row.begin(), row.end())));
+        }
+        EXPECT_EQ(ex_min, argmin(b, 1));
+        EXPECT_EQ(ex_max, argmax(b, 1));
+    }
+
     TEST(xsort, sort_large_prob)
     {
         for (std::size_t i = 0; i < 20; ++i)
@@ -95,6 +136,351 @@ namespace xt
         }
     }
 
+    TEST(xsort, sort_strided)
+    {
+        xarray<double> a = xt::random::rand<double>({4, 7, 13});
+        xarray<double, layout_type::column_major> ca = a;
+        auto res = sort(a, 1);
+        auto cres = sort(ca, 1);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            for (std::size_t k = 0; k < 13; ++k)
+            {
+                auto lane = view(a, i, xt::all(), k);
+                std::vector<double> expected(lane.begin(), lane.end());
+                std::sort(expected.begin(), expected.end());
+                auto res_lane = view(res, i, xt::all(), k);
+                auto cres_lane = view(cres, i, xt::all(), k);
+                EXPECT_TRUE(std::equal(expected.begin(), expected.end(), res_lane.begin()));
+                EXPECT_TRUE(std::equal(expected.begin(), expected.end(), cres_lane.begin()));
+            }
+        }
+    }
+
+    TEST(xsort, parallel)
+    {
+        xarray<double> a = xt::random::rand<double>({5, 5, 100, 10});
+        for (std::size_t axis = 0; axis < 4; ++axis)
+        {
+            EXPECT_EQ(sort(a, axis), sort(a, axis, evaluation_strategy::parallel()));
+        }
+        EXPECT_EQ(sort(a), sort(a, evaluation_strategy::parallel()));
+
+        xarray<double> b = xt::random::rand<double>({3 * (XTENSOR_PARALLEL_GRAIN_SIZE + 4)});
+        xarray<double> flat = b;
+        flat.reshape({3, XTENSOR_PARALLEL_GRAIN_SIZE + 4, 1});
+        auto res = sort(flat, xnone(), evaluation_strategy::parallel());
+        EXPECT_EQ(b.size(), res.size());
+        EXPECT_TRUE(std::is_sorted(res.cbegin(), res.cend()));
+        EXPECT_EQ(sort(b), res);
+
+        // Values without radix keys go through the parallel merge sort
+        std::size_t n = 4 * XTENSOR_PARALLEL_GRAIN_SIZE + 5;
+        using pair_type = std::pair<double, std::size_t>;
+        xarray<pair_type> p = xarray<pair_type>::from_shape({n});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            p(i) = pair_type(b((i * 7919) % b.size()), i % 3);
+        }
+        std::vector<pair_type> expected(p.cbegin(), p.cend());
+        std::sort(expected.begin(), expected.end());
+        auto pres = sort(p, xnone(), evaluation_strategy::parallel());
+        EXPECT_EQ(n, pres.size());
+        EXPECT_TRUE(std::equal(expected.cbegin(), expected.cend(), pres.cbegin()));
+    }
+
+    template <class T>
+    void check_radix_sort(const xarray<T>& a)
+    {
+        std::vector<T> expected(a.cbegin(), a.cend());
+        std::sort(expected.begin(), expected.end());
+        auto res = sort(a, xnone());
+        auto res_par = sort(a, xnone(), evaluation_strategy::parallel());
+        EXPECT_TRUE(std::equal(expected.cbegin(), expected.cend(), res.cbegin()));
+        EXPECT_TRUE(std::equal(expected.cbegin(), expected.cend(), res_par.cbegin()));
+    }
+
+    TEST(xsort, radix_sort)
+    {
+        std::size_t n = 2 * XTENSOR_PARALLEL_GRAIN_SIZE + 17;
+        xarray<double> d = xt::random::randn<double>({n}) * 1e3;
+        d(0) = -0.0;
+        d(1) = std::numeric_limits<double>::infinity();
+        d(2) = -std::numeric_limits<double>::infinity();
+        check_radix_sort(d);
+        check_radix_sort(xarray<float>(xt::cast<float>(d)));
+        check_radix_sort(xarray<int>(xt::random::randint<int>({n}, -100000, 100000)));
+        check_radix_sort(xarray<std::int64_t>(xt::random::randint<std::int64_t>({n}, -(std::int64_t(1) << 40), std::int64_t(1) << 40)));
+        check_radix_sort(xarray<std::uint32_t>(xt::random::randint<std::uint32_t>({n}, 0, 4000000000u)));
+        check_radix_sort(xarray<std::int8_t>(xt::cast<std::int8_t>(xt::random::randint<int>({n}, -128, 128))));
+
+        // all the elements have the same high bytes
+        check_radix_sort(xarray<std::uint64_t>(xt::random::randint<std::uint64_t>({n}, 0, 256)));
+
+        xarray<int> b = xt::random::randint<int>({3, 2000, 5}, -1000, 1000);
+        auto res = sort(b, 1);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t k = 0; k < 5; ++k)
+            {
+                auto lane = view(res, i, xt::all(), k);
+                EXPECT_TRUE(std::is_sorted(lane.begin(), lane.end()));
+                EXPECT_EQ(sum(view(b, i, xt::all(), k))(), sum(lane)());
+            }
+        }
+    }
+
+    TEST(xsort, argsort)
+    {
+        xarray<double> a = {{5, 3, 1}, {4, 4, 2}};
+
+        xarray<std::size_t> ex_0 = {{1, 0, 0}, {0, 1, 1}};
+        EXPECT_EQ(ex_0, argsort(a, 0));
+
+        xarray<std::size_t> ex_1 = {{2, 1, 0}, {2, 0, 1}};
+        EXPECT_EQ(ex_1, argsort(a, 1, sorting_method::stable));
+        EXPECT_EQ(ex_1, argsort(a, sorting_method::stable));
+
+        xarray<std::size_t> ex_flat = {2, 5, 1, 3, 4, 0};
+        EXPECT_EQ(ex_flat, argsort(a, xnone(), sorting_method::stable));
+
+        xarray<double> b = xt::random::rand<double>({4, 7, 13});
+        xarray<double, layout_type::column_major> cb = b;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            auto idx = argsort(b, axis);
+            EXPECT_EQ(idx, argsort(cb, axis));
+            auto sorted = sort(b, axis);
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                for (std::size_t j = 0; j < 7; ++j)
+                {
+                    for (std::size_t k = 0; k < 13; ++k)
+                    {
+                        std::array<std::size_t, 3> index = {i, j, k};
+                        index[axis] = idx(i, j, k);
+                        EXPECT_EQ(sorted(i, j, k), b[index]);
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(xsort, partition)
+    {
+        xarray<double> a = xt::random::rand<double>({5, 40, 3});
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            std::size_t kth = a.shape()[axis] / 2;
+            auto sorted = sort(a, axis);
+            auto part = partition(a, kth, axis);
+            auto idx = argpartition(a, kth, axis);
+            for (std::size_t i = 0; i < 5; ++i)
+            {
+                for (std::size_t j = 0; j < 40; ++j)
+                {
+                    for (std::size_t k = 0; k < 3; ++k)
+                    {
+                        std::array<std::size_t, 3> index = {i, j, k};
+                        std::array<std::size_t, 3> kth_index = index;
+                        kth_index[axis] = kth;
+                        auto pivot = sorted[kth_index];
+                        EXPECT_EQ(pivot, part[kth_index]);
+                        bool before = index[axis] < kth;
+                        EXPECT_TRUE(before ? part[index] <= pivot : part[index] >= pivot);
+
+                        std::array<std::size_t, 3> arg_index = index;
+                        arg_index[axis] = idx[index];
+                        EXPECT_TRUE(before ? a[arg_index] <= pivot : a[arg_index] >= pivot);
+                        if (index[axis] == kth)
+                        {
+                            EXPECT_EQ(pivot, a[arg_index]);
+                        }
+                    }
+                }
+            }
+        }
+
+        xarray<int> b = {7, 1, 5, 3, 9};
+        EXPECT_EQ(5, partition(b, 2)(2));
+        EXPECT_EQ(2u, argpartition(b, 2)(2));
+        EXPECT_EQ(5, partition(b, 2, xnone())(2));
+        EXPECT_EQ(2u, argpartition(b, 2, xnone())(2));
+        EXPECT_THROW(partition(b, 5), std::out_of_range);
+    }
+
+    TEST(xsort, topk)
+    {
+        xarray<double> a = {{5, 3, 1, 3}, {4, 8, 2, 6}};
+
+        auto res = topk(a, 2);
+        xarray<double> ex_values = {{5, 3}, {8, 6}};
+        xarray<std::size_t> ex_indices = {{0, 1}, {1, 3}};
+        EXPECT_EQ(ex_values, res.first);
+        EXPECT_EQ(ex_indices, res.second);
+
+        auto res_0 = topk(a, 1, 0);
+        xarray<double> ex_values_0 = {{5, 8, 2, 6}};
+        xarray<std::size_t> ex_indices_0 = {{0, 1, 1, 1}};
+        EXPECT_EQ(ex_values_0, res_0.first);
+        EXPECT_EQ(ex_indices_0, res_0.second);
+
+        xtensor<double, 2> t = xt::random::rand<double>({3, 1000});
+        auto res_t = topk(t, 10, 1);
+        auto sorted = sort(t, 1);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 10; ++j)
+            {
+                EXPECT_EQ(sorted(i, 999 - j), res_t.first(i, j));
+                EXPECT_EQ(t(i, res_t.second(i, j)), res_t.first(i, j));
+            }
+        }
+        EXPECT_THROW(topk(a, 5), std::out_of_range);
+    }
+
+    TEST(xsort, quantile)
+    {
+        xarray<int> a = {{3, 1, 4, 1}, {5, 9, 2, 6}};
+
+        EXPECT_EQ(3.5, median(a));
+        EXPECT_EQ(1., quantile(a, 0.));
+        EXPECT_EQ(9., quantile(a, 1.));
+        EXPECT_EQ(1.75, percentile(a, 25.));
+
+        xarray<double> ex_0 = {4., 5., 3., 3.5};
+        EXPECT_EQ(ex_0, median(a, 0));
+        xarray<double> ex_1 = {2., 5.5};
+        EXPECT_EQ(ex_1, median(a, 1));
+
+        xarray<double> ex_q = {{1., 4.25}, {2., 5.5}, {3.25, 6.75}};
+        EXPECT_EQ(ex_q, quantile(a, {0.25, 0.5, 0.75}, 1));
+        EXPECT_EQ(ex_q, percentile(a, {25., 50., 75.}, 1));
+        xarray<double> ex_flat = {1., 3.5, 9.};
+        EXPECT_EQ(ex_flat, quantile(a, {0., 0.5, 1.}));
+
+        EXPECT_THROW(quantile(a, 1.5, 1), std::out_of_range);
+        EXPECT_THROW(quantile(a, 0.5, 2), std::out_of_range);
+        EXPECT_THROW(quantile(a, {0.25, 0.75}, 2), std::out_of_range);
+        EXPECT_THROW(median(a, 2), std::out_of_range);
+        EXPECT_THROW(percentile(a, 50., 3), std::out_of_range);
+
+        xarray<double> b = xt::random::rand<double>({6, 101, 7});
+        xtensor<double, 3> tb = b;
+        xarray<double, layout_type::column_major> cb = b;
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            auto sorted = sort(b, axis);
+            auto med = median(b, axis);
+            auto qs = quantile(b, {0.1, 0.5, 0.9}, axis);
+            EXPECT_EQ(med, median(tb, axis));
+            EXPECT_EQ(med, median(cb, axis, evaluation_strategy::parallel()));
+            EXPECT_EQ(qs, quantile(cb, {0.1, 0.5, 0.9}, axis, evaluation_strategy::parallel()));
+
+            std::size_t n = b.shape()[axis];
+            for (std::size_t i = 0; i < med.size(); ++i)
+            {
+                std::vector<std::size_t> index(3);
+                std::size_t l = i;
+                for (std::size_t d = 3; d-- != 0;)
+                {
+                    if (d != axis)
+                    {
+                        index[d] = l % b.shape()[d];
+                        l /= b.shape()[d];
+                    }
+                }
+                auto at = [&](double q) {
+                    double pos = q * static_cast<double>(n - 1);
+                    std::size_t lo = static_cast<std::size_t>(pos);
+                    std::vector<std::size_t> idx = index;
+                    idx[axis] = lo;
+                    double v = sorted[idx];
+                    if (lo + 1 < n)
+                    {
+                        idx[axis] = lo + 1;
+                        v += (pos - static_cast<double>(lo)) * (sorted[idx] - v);
+                    }
+                    return v;
+                };
+                EXPECT_DOUBLE_EQ(at(0.5), med.data()[i]);
+                EXPECT_DOUBLE_EQ(at(0.1), qs.data()[i]);
+                EXPECT_DOUBLE_EQ(at(0.9), qs.data()[2 * med.size() + i]);
+            }
+        }
+    }
+
+    TEST(xsort, unique)
+    {
+        xarray<int> a = {{3, 1, 4}, {1, 5, 3}};
+
+        xtensor<int, 1> ex = {1, 3, 4, 5};
+        EXPECT_EQ(ex, unique(a));
+
+        xtensor<std::size_t, 1> ex_counts = {2, 2, 1, 1};
+        xtensor<std::size_t, 1> ex_inverse = {1, 0, 2, 0, 3, 1};
+        auto uc = unique_counts(a);
+        EXPECT_EQ(ex, std::get<0>(uc));
+        EXPECT_EQ(ex_counts, std::get<1>(uc));
+        auto ui = unique_inverse(a);
+        EXPECT_EQ(ex, std::get<0>(ui));
+        EXPECT_EQ(ex_inverse, std::get<1>(ui));
+        auto uic = unique_inverse_counts(a);
+        EXPECT_EQ(ex, std::get<0>(uic));
+        EXPECT_EQ(ex_inverse, std::get<1>(uic));
+        EXPECT_EQ(ex_counts, std::get<2>(uic));
+
+        xtensor<int, 1> b = xt::random::randint<int>({5000}, 0, 300);
+        auto ub = unique_inverse(b);
+        const auto& values = std::get<0>(ub);
+        const auto& inverse = std::get<1>(ub);
+        EXPECT_TRUE(std::adjacent_find(values.cbegin(), values.cend(), std::greater_equal<int>()) == values.cend());
+        for (std::size_t i = 0; i < b.size(); ++i)
+        {
+            EXPECT_EQ(b(i), values(inverse(i)));
+        }
+    }
+
+    TEST(xsort, searchsorted)
+    {
+        xtensor<double, 1> a = {1., 2., 2., 3., 5.};
+        xarray<double> v = {{0., 1., 2.}, {2.5, 5., 6.}};
+
+        xarray<std::size_t> ex_left = {{0, 0, 1}, {3, 4, 5}};
+        xarray<std::size_t> ex_right = {{0, 1, 3}, {3, 5, 5}};
+        EXPECT_EQ(ex_left, searchsorted(a, v));
+        EXPECT_EQ(ex_right, searchsorted(a, v, search_side::right));
+
+        std::array<std::size_t, 1> empty_shape = {0};
+        xtensor<double, 1> empty(empty_shape);
+        xarray<std::size_t> ex_empty = {{0, 0, 0}, {0, 0, 0}};
+        EXPECT_EQ(ex_empty, searchsorted(empty, v));
+
+        xtensor<int, 1> s = sort(xtensor<int, 1>(xt::random::randint<int>({1000}, 0, 500)));
+        xtensor<int, 1> q = xt::random::randint<int>({1037}, -10, 510);
+        auto left = searchsorted(s, q);
+        auto right = searchsorted(s, q, search_side::right);
+        for (std::size_t i = 0; i < q.size(); ++i)
+        {
+            auto lb = std::lower_bound(s.cbegin(), s.cend(), q(i));
+            auto ub = std::upper_bound(s.cbegin(), s.cend(), q(i));
+            EXPECT_EQ(static_cast<std::size_t>(std::distance(s.cbegin(), lb)), left(i));
+            EXPECT_EQ(static_cast<std::size_t>(std::distance(s.cbegin(), ub)), right(i));
+        }
+    }
+
+    TEST(xsort, set_operations)
+    {
+        xarray<int> a = {5, 1, 3, 3, 7, 9};
+        xarray<int> b = {{3, 4}, {9, 9}};
+
+        xtensor<int, 1> ex_inter = {3, 9};
+        xtensor<int, 1> ex_diff = {1, 5, 7};
+        EXPECT_EQ(ex_inter, intersect1d(a, b));
+        EXPECT_EQ(ex_diff, setdiff1d(a, b));
+        EXPECT_EQ(0u, setdiff1d(b, b).size());
+    }
+
     TEST(xsort, argmax_prob)
     {
         for (std::size_t i = 0; i < 20; ++i)
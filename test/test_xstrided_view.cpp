@@ -67,4 +67,31 @@ namespace xt
         EXPECT_EQ(cbw2.layout(), layout_type::row_major);
         EXPECT_EQ(cbw3.layout(), layout_type::dynamic);
     }
+
+    TEST(xstrided_view, blocked_transpose_assign)
+    {
+        xarray<double> a = xt::arange<double>(3 * 70 * 90);
+        a.reshape({3, 70, 90});
+
+        xarray<double> res = transpose(a, {0, 2, 1});
+        shape_t expected_shape = {3, 90, 70};
+        EXPECT_TRUE(std::equal(expected_shape.cbegin(), expected_shape.cend(), res.shape().cbegin()));
+
+        xarray<float> fres = transpose(a);
+        xarray<double, layout_type::column_major> cres = a;
+        xarray<double> rres = cres;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            for (size_t j = 0; j < 70; ++j)
+            {
+                for (size_t k = 0; k < 90; ++k)
+                {
+                    EXPECT_EQ(a(i, j, k), res(i, k, j));
+                    EXPECT_EQ(float(a(i, j, k)), fres(k, j, i));
+                    EXPECT_EQ(a(i, j, k), cres(i, j, k));
+                }
+            }
+        }
+        EXPECT_EQ(a, rres);
+    }
 }
@@ -9,6 +9,10 @@
 #include "gtest/gtest.h"
 #include "xtensor/xtensor.hpp"
 #include "xtensor/xarray.hpp"
+#include "xtensor/xassign_stats.hpp"
+#include "xtensor/xmath.hpp"
+#include "xtensor/xstrided_view.hpp"
+#include "xtensor/xview.hpp"
 #include "test_common.hpp"
 
 namespace xt
@@ -71,4 +75,102 @@ namespace xt
         double_tensor dres = i32t;
         EXPECT_EQ(dres, dt);
     }
+
+    TEST(xtensor_semantic, mixed_type_assign)
+    {
+        std::size_t n = 37;
+        xtensor<int16_t, 1> i16t = xtensor<int16_t, 1>::from_shape({n});
+        xtensor<int32_t, 1> i32t = xtensor<int32_t, 1>::from_shape({n});
+        xtensor<float, 1> ft = xtensor<float, 1>::from_shape({n});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            i16t(i) = int16_t(int(i) - 20);
+            i32t(i) = int32_t(i) * 3 - 50;
+            ft(i) = float(i) * 0.3f - 5.f;
+        }
+
+        xtensor<float, 1> fres = i16t;
+        xtensor<double, 1> dres = ft;
+        xtensor<double, 1> dres2 = ft * 2.0;
+        xtensor<float, 1> fres2 = i32t + 1;
+        xtensor<int32_t, 1> ires = ft * 2.f;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(float(i16t(i)), fres(i));
+            EXPECT_EQ(double(ft(i)), dres(i));
+            EXPECT_EQ(double(ft(i)) * 2.0, dres2(i));
+            EXPECT_EQ(float(i32t(i) + 1), fres2(i));
+            EXPECT_EQ(static_cast<int32_t>(ft(i) * 2.f), ires(i));
+        }
+    }
+
+    TEST(xtensor_semantic, memory_overlap)
+    {
+        array_type a = {{1., 2., 3.}, {4., 5., 6.}, {7., 8., 9.}};
+        array_type b = {{1., 1., 1.}, {2., 2., 2.}, {3., 3., 3.}};
+        auto va = view(a, range(1, 3), all());
+        EXPECT_EQ(detail::overlap_type::none, detail::memory_overlap(a, b * 2.));
+        EXPECT_EQ(detail::overlap_type::elementwise, detail::memory_overlap(a, a + b));
+        EXPECT_EQ(detail::overlap_type::unsafe, detail::memory_overlap(a, a + transpose(a)));
+        EXPECT_EQ(detail::overlap_type::unsafe, detail::memory_overlap(a, va));
+        EXPECT_EQ(detail::overlap_type::unsafe, detail::memory_overlap(a, a(1, 1) * b));
+        EXPECT_EQ(detail::overlap_type::elementwise, detail::memory_overlap(va, sin(va)));
+        EXPECT_EQ(detail::overlap_type::none, detail::memory_overlap(view(a, 0), view(a, 1)));
+    }
+
+    TEST(xtensor_semantic, aliased_assign)
+    {
+        array_type a = {{1., 2., 3.}, {4., 5., 6.}, {7., 8., 9.}};
+        array_type b = {{1., 1., 1.}, {2., 2., 2.}, {3., 3., 3.}};
+        array_type c = a;
+
+        const double* data = a.raw_data();
+        a += b * c;
+        EXPECT_EQ(data, a.raw_data());
+        EXPECT_EQ(array_type(c + b * c), a);
+
+        a = b * c;
+        EXPECT_EQ(data, a.raw_data());
+        EXPECT_EQ(array_type(b * c), a);
+
+        a = c;
+        a = transpose(a) + 1.;
+        EXPECT_EQ(array_type(transpose(c) + 1.), a);
+
+        // The rhs must not be an xview of the same type, which would call
+        // the copy assignment operator of xview.
+        a = c;
+        auto va = view(a, range(0, 2), all());
+        reset_assign_stats();
+        va = view(a, range(1, 3), all()) * 1.;
+        array_type expected = {{4., 5., 6.}, {7., 8., 9.}, {7., 8., 9.}};
+        EXPECT_EQ(expected, a);
+#ifdef XTENSOR_ENABLE_ASSIGN_STATS
+        EXPECT_EQ(1u, get_assign_stats().temporaries);
+#endif
+
+        a = c;
+        reset_assign_stats();
+        va = va * 2.;
+        array_type expected2 = {{2., 4., 6.}, {8., 10., 12.}, {7., 8., 9.}};
+        EXPECT_EQ(expected2, a);
+#ifdef XTENSOR_ENABLE_ASSIGN_STATS
+        EXPECT_EQ(0u, get_assign_stats().temporaries);
+#endif
+
+        a = c;
+        auto v0 = view(a, range(0, 1), all());
+        reset_assign_stats();
+        v0 = dynamic_view(a, slice_vector({range(2, 3), all()}));
+        array_type expected3 = {{7., 8., 9.}, {4., 5., 6.}, {7., 8., 9.}};
+        EXPECT_EQ(expected3, a);
+#ifdef XTENSOR_ENABLE_ASSIGN_STATS
+        EXPECT_EQ(0u, get_assign_stats().temporaries);
+#endif
+
+        xarray<double> r = {1., 2., 3.};
+        r += b;
+        array_type rexpected = {{2., 3., 4.}, {3., 4., 5.}, {4., 5., 6.}};
+        EXPECT_EQ(rexpected, r);
+    }
 }
@@ -453,4 +453,126 @@ namespace xt
 
         EXPECT_EQ(res, a);
     }
+
+    TYPED_TEST(view_semantic, inner_loop_assign)
+    {
+        using container_1d = redim_container_t<TypeParam, 1>;
+        using container_2d = redim_container_t<TypeParam, 2>;
+        std::size_t n = 19;
+        typename container_2d::shape_type shape_2d = {5, n};
+        typename container_1d::shape_type shape_1d = {n};
+        container_2d a(shape_2d);
+        container_2d b(shape_2d);
+        container_1d c(shape_1d);
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                a(i, j) = 0;
+                b(i, j) = int(i * n + j);
+                c(j) = int(j) * 2;
+            }
+        }
+
+        {
+            SCOPED_TRACE("contiguous rows and broadcast row");
+            container_2d r = a;
+            view(r, range(1, 4), all()) = view(b, range(0, 3), all()) + c;
+            for (std::size_t i = 0; i < 5; ++i)
+            {
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    int expected = (i >= 1 && i < 4) ? b(i - 1, j) + c(j) : 0;
+                    EXPECT_EQ(expected, r(i, j));
+                }
+            }
+        }
+
+        {
+            SCOPED_TRACE("broadcast column");
+            container_2d r = a;
+            auto col = view(b, all(), 3, newaxis());
+            auto vr = view(r, range(1, 5), all());
+            noalias(vr) = view(col, range(0, 4), all()) * 3;
+            for (std::size_t i = 1; i < 5; ++i)
+            {
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    EXPECT_EQ(b(i - 1, 3) * 3, r(i, j));
+                }
+            }
+        }
+
+        {
+            SCOPED_TRACE("strided inner dimension");
+            container_2d r = a;
+            view(r, all(), range(0, int(n) - 1, 2)) = view(b, all(), range(1, int(n), 2));
+            for (std::size_t i = 0; i < 5; ++i)
+            {
+                for (std::size_t j = 0; j + 1 < n; j += 2)
+                {
+                    EXPECT_EQ(b(i, j + 1), r(i, j));
+                    EXPECT_EQ(0, r(i, j + 1));
+                }
+            }
+        }
+    }
+
+    TYPED_TEST(view_semantic, collapsed_assign)
+    {
+        using container_3d = redim_container_t<TypeParam, 3>;
+        using container_4d = redim_container_t<TypeParam, 4>;
+        typename container_4d::shape_type shape_4d = {4, 3, 5, 7};
+        typename container_3d::shape_type shape_3d = {3, 1, 7};
+        container_4d a(shape_4d, 0);
+        container_4d b(shape_4d);
+        container_3d c(shape_3d);
+        for (std::size_t i = 0; i < b.size(); ++i)
+        {
+            b.data()[i] = int(i);
+        }
+        for (std::size_t i = 0; i < c.size(); ++i)
+        {
+            c.data()[i] = int(i) * 10;
+        }
+
+        {
+            SCOPED_TRACE("view dropping the outer axis");
+            container_4d r = a;
+            view(r, range(1, 3)) = view(b, range(0, 2)) + 1;
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    for (std::size_t k = 0; k < 5; ++k)
+                    {
+                        for (std::size_t l = 0; l < 7; ++l)
+                        {
+                            int expected = (i >= 1 && i < 3) ? b(i - 1, j, k, l) + 1 : 0;
+                            EXPECT_EQ(expected, r(i, j, k, l));
+                        }
+                    }
+                }
+            }
+        }
+
+        {
+            SCOPED_TRACE("broadcast operand breaking the merge");
+            container_4d r = a;
+            view(r, range(1, 3)) = view(b, range(0, 2)) + c;
+            for (std::size_t i = 1; i < 3; ++i)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    for (std::size_t k = 0; k < 5; ++k)
+                    {
+                        for (std::size_t l = 0; l < 7; ++l)
+                        {
+                            EXPECT_EQ(b(i - 1, j, k, l) + c(j, 0, l), r(i, j, k, l));
+                        }
+                    }
+                }
+            }
+        }
+    }
 }